@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+class GameContext;
+
+namespace Bench {
+    struct Stats {
+        double median;
+        double mad;
+    };
+
+    // Median and median absolute deviation of a set of timings.
+    inline Stats Summarize(std::vector<double> times) {
+        if (times.empty()) return {0.0, 0.0};
+
+        std::sort(times.begin(), times.end());
+        double median = times[times.size() / 2];
+
+        std::vector<double> deviations(times.size());
+        for (size_t s = 0; s < times.size(); s++) {
+            deviations[s] = std::fabs(times[s] - median);
+        }
+        std::sort(deviations.begin(), deviations.end());
+
+        return {median, deviations[deviations.size() / 2]};
+    }
+
+    // Times `samples` batches of `iterations` calls and returns nanoseconds per call.
+    template <typename Fn>
+    Stats Measure(Fn&& fn, int samples, int iterations) {
+        using Clock = std::chrono::steady_clock;
+
+        for (int i = 0; i < iterations; i++) {
+            fn();
+        }
+
+        std::vector<double> times(samples);
+        for (int s = 0; s < samples; s++) {
+            auto start = Clock::now();
+            for (int i = 0; i < iterations; i++) {
+                fn();
+            }
+            std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            times[s] = elapsed.count() / iterations;
+        }
+
+        return Summarize(std::move(times));
+    }
+
+    // Times a single call; for work that can only happen once per input.
+    template <typename Fn>
+    double TimeOnce(Fn&& fn) {
+        using Clock = std::chrono::steady_clock;
+
+        auto start = Clock::now();
+        fn();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    inline void Report(const std::string& name, const Stats& stats) {
+        std::printf("%-40s %12.1f ns  +/- %8.1f ns\n", name.c_str(), stats.median, stats.mad);
+    }
+
+    inline void ReportRate(const std::string& name, const Stats& stats, double itemsPerCall, const char* unit) {
+        double rate = stats.median > 0.0 ? itemsPerCall * 1e9 / stats.median : 0.0;
+        std::printf("%-40s %12.1f ns  +/- %8.1f ns  %10.2f M%s/s\n",
+                    name.c_str(), stats.median, stats.mad, rate / 1e6, unit);
+    }
+
+    inline void Skip(const std::string& name, const char* reason) {
+        std::printf("%-40s skipped: %s\n", name.c_str(), reason);
+    }
+
+    // A fully initialised game context on SDL's offscreen video driver and
+    // software renderer, so rendering benchmarks need no display or GPU.
+    // Null if it could not be created.
+    GameContext* GetOffscreenContext();
+}
@@ -0,0 +1,47 @@
+#include "graphics/FlashVariants.hpp"
+#include "graphics/OverdrawMap.hpp"
+#include "graphics/UploadQueue.hpp"
+#include <cstdio>
+#include <cstring>
+
+void RunCollisionBench();
+void RunFontParseBench();
+void RunFontBench();
+void RunTextureBench();
+void RunModBench();
+void RunTitleBench();
+
+namespace {
+    struct Suite {
+        const char* name;
+        void (*run)();
+    };
+
+    const Suite SUITES[] = {
+        {"collision", RunCollisionBench},
+        {"fontparse", RunFontParseBench},
+        {"font", RunFontBench},
+        {"texture", RunTextureBench},
+        {"mods", RunModBench},
+        {"title", RunTitleBench}
+    };
+}
+
+// Run from the game directory so data/ and mods/ resolve. Pass suite names
+// to run only those.
+int main(int argc, char* args[]) {
+    std::printf("S2HD++ microbenchmarks\n");
+    for (const auto& suite : SUITES) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(args[i], suite.name) == 0) selected = true;
+        }
+        if (selected) suite.run();
+    }
+
+    // The offscreen context is a static too; free textures before it goes.
+    UploadQueue::GetInstance().Shutdown();
+    FlashVariants::GetInstance().Shutdown();
+    OverdrawMap::GetInstance().Shutdown();
+    return 0;
+}
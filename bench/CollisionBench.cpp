@@ -0,0 +1,54 @@
+#include "Bench.hpp"
+#include "level/TerrainCollision.hpp"
+#include <random>
+
+void RunCollisionBench() {
+    std::mt19937 rng(2);
+
+    const int blockCount = 256;
+    std::vector<int8_t> heights(blockCount * TerrainCollision::BLOCK_SIZE);
+    std::vector<uint8_t> angles(blockCount);
+    for (int block = 1; block < blockCount; block++) {
+        for (int column = 0; column < TerrainCollision::BLOCK_SIZE; column++) {
+            heights[block * TerrainCollision::BLOCK_SIZE + column] = static_cast<int8_t>(rng() % 17);
+        }
+        angles[block] = static_cast<uint8_t>((rng() % 128) * 2);
+    }
+
+    // Roughly the size of an Emerald Hill act in 16x16 blocks.
+    const int width = 680, height = 64;
+    std::vector<uint16_t> cells(width * height);
+    for (auto& cell : cells) {
+        cell = static_cast<uint16_t>((rng() % blockCount) | (rng() & 0x3C00));
+    }
+
+    TerrainCollision terrain;
+    terrain.SetBlocks(heights, angles);
+    terrain.SetLayout(width, height, cells);
+
+    const size_t sensors = 1024;
+    std::vector<int32_t> x(sensors), y(sensors), distance(sensors);
+    std::vector<uint8_t> angle(sensors);
+    for (size_t i = 0; i < sensors; i++) {
+        x[i] = static_cast<int32_t>(rng() % terrain.GetWidth());
+        y[i] = static_cast<int32_t>(rng() % terrain.GetHeight());
+    }
+
+    const char* names[] = {"down", "up", "right", "left"};
+    for (int dir = 0; dir < 4; dir++) {
+        auto direction = static_cast<SensorDirection>(dir);
+
+        Bench::Stats batched = Bench::Measure([&]() {
+            terrain.Query(direction, x.data(), y.data(), sensors, distance.data(), angle.data());
+        }, 31, 64);
+        Bench::ReportRate(std::string("collision/batched/") + names[dir], batched, sensors, "queries");
+
+        Bench::Stats single = Bench::Measure([&]() {
+            for (size_t i = 0; i < sensors; i++) {
+                SensorResult result = terrain.Query(direction, x[i], y[i]);
+                distance[i] = result.distance;
+            }
+        }, 31, 64);
+        Bench::ReportRate(std::string("collision/single/") + names[dir], single, sensors, "queries");
+    }
+}
@@ -0,0 +1,85 @@
+#include "Bench.hpp"
+#include <core/GameContext.hpp>
+#include <graphics/BitmapFont.hpp>
+#include <tinyxml2.h>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    struct FontCase {
+        const char* name;
+        const char* font;
+        const char* directory;
+    };
+
+    const FontCase FONTS[] = {
+        {"hud", "data/SONICORCA/FONTS/HUD.font", "data/SONICORCA/FONTS/HUD"},
+        {"impact", "data/SONICORCA/FONTS/IMPACT/REGULAR.font", "data/SONICORCA/FONTS/IMPACT/REGULAR"}
+    };
+
+    const char* const SAMPLE_TEXT = "SCORE 1234560  TIME 9:59  RINGS 999";
+
+    int CountNodes(const tinyxml2::XMLElement* element) {
+        int count = 0;
+        for (; element; element = element->NextSiblingElement()) {
+            count++;
+            for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute(); attribute; attribute = attribute->Next()) {
+                count++;
+            }
+            count += CountNodes(element->FirstChildElement());
+        }
+        return count;
+    }
+}
+
+void RunFontParseBench() {
+    for (const auto& font : FONTS) {
+        std::string name = std::string("font/parse/") + font.name;
+        std::ifstream file(font.font, std::ios::binary);
+        if (!file.is_open()) {
+            Bench::Skip(name, "font not found");
+            continue;
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+        std::string text = contents.str();
+
+        int nodes = 0;
+        Bench::Stats stats = Bench::Measure([&]() {
+            tinyxml2::XMLDocument document;
+            document.Parse(text.c_str(), text.size());
+            nodes = CountNodes(document.RootElement());
+        }, 31, 32);
+        Bench::ReportRate(name, stats, nodes, "nodes");
+    }
+}
+
+void RunFontBench() {
+    GameContext* context = Bench::GetOffscreenContext();
+    if (!context) {
+        Bench::Skip("font/*", "no offscreen renderer");
+        return;
+    }
+    SDL_Renderer* renderer = context->GetRenderer();
+
+    for (const auto& font : FONTS) {
+        BitmapFont bitmapFont;
+        if (!bitmapFont.Load(font.font, renderer, font.directory)) {
+            Bench::Skip(std::string("font/") + font.name, "font not found");
+            continue;
+        }
+
+        int width = 0;
+        Bench::Stats measure = Bench::Measure([&]() {
+            width += bitmapFont.GetTextWidth(SAMPLE_TEXT);
+        }, 31, 1024);
+        Bench::Report(std::string("font/width/") + font.name, measure);
+
+        // Flushing makes the software renderer rasterise inside the timing.
+        Bench::Stats render = Bench::Measure([&]() {
+            bitmapFont.RenderText(renderer, SAMPLE_TEXT, 32, 32);
+            SDL_RenderFlush(renderer);
+        }, 31, 64);
+        Bench::Report(std::string("font/render/") + font.name, render);
+    }
+}
@@ -0,0 +1,22 @@
+#include "Bench.hpp"
+#include <core/GameContext.hpp>
+#include <memory>
+
+GameContext* Bench::GetOffscreenContext() {
+    static std::unique_ptr<GameContext> context;
+    static bool attempted = false;
+    if (attempted) return context.get();
+    attempted = true;
+
+    // Hints must be in place before the context brings up SDL video.
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+
+    context = std::make_unique<GameContext>();
+    if (!context->Initialize() || !context->GetRenderer()) {
+        std::printf("Offscreen renderer unavailable: %s\n", SDL_GetError());
+        context.reset();
+    }
+    return context.get();
+}
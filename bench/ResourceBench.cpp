@@ -0,0 +1,117 @@
+#include "Bench.hpp"
+#include "mods/ModIndex.hpp"
+#include "resources/TextureCache.hpp"
+#include "states/Title/TitleResources.hpp"
+#include <core/GameContext.hpp>
+#include <resources/ResourceManager.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+
+namespace {
+    const std::string DATA_DIRECTORY = "data/SONICORCA/";
+}
+
+void RunTextureBench() {
+    GameContext* context = Bench::GetOffscreenContext();
+    if (!context) {
+        Bench::Skip("texture/*", "no offscreen renderer");
+        return;
+    }
+
+    // Every title texture is new to the manager the first time, so the first
+    // pass is all misses and the second all hits.
+    std::vector<std::string> paths;
+    for (const AssetId& asset : TitleResources::GetTextures()) {
+        paths.push_back(asset.GetSonicOrcaPath());
+    }
+    std::vector<double> misses, hits;
+    for (const auto& path : paths) {
+        if (!std::filesystem::exists(DATA_DIRECTORY + path)) continue;
+        misses.push_back(Bench::TimeOnce([&]() { ResourceManager::GetInstance().LoadTexture(path); }));
+    }
+    if (misses.empty()) {
+        Bench::Skip("texture/manager", "title textures not found");
+        return;
+    }
+    for (int pass = 0; pass < 31; pass++) {
+        for (const auto& path : paths) {
+            hits.push_back(Bench::TimeOnce([&]() { ResourceManager::GetInstance().LoadTexture(path); }));
+        }
+    }
+    Bench::Report("texture/manager/miss", Bench::Summarize(misses));
+    Bench::Report("texture/manager/hit", Bench::Summarize(hits));
+
+    // The decoded-pixel cache: a miss decodes the PNG and writes the entry,
+    // a hit reads the raw entry back.
+    std::string source = DATA_DIRECTORY + paths.front();
+    std::string entry = TextureCache::GetEntryPath(source);
+    Bench::Stats decode = Bench::Measure([&]() {
+        std::remove(entry.c_str());
+        SDL_FreeSurface(TextureCache::LoadSurface(source));
+    }, 15, 2);
+    Bench::Report("texture/cache/miss", decode);
+
+    Bench::Stats cached = Bench::Measure([&]() {
+        SDL_FreeSurface(TextureCache::LoadSurface(source));
+    }, 31, 4);
+    Bench::Report("texture/cache/hit", cached);
+}
+
+void RunModBench() {
+    ModIndex& mods = ModIndex::GetInstance();
+    // Without the manifest every mod is scanned and the manifest rewritten;
+    // with it, Load only checks the recorded mtimes.
+    Bench::Stats scan = Bench::Measure([&]() {
+        std::remove(ModIndex::MANIFEST_PATH);
+        mods.Load();
+    }, 15, 1);
+    Bench::Report("mods/load/scan", scan);
+
+    Bench::Stats manifest = Bench::Measure([&]() { mods.Load(); }, 15, 1);
+    Bench::Report("mods/load/manifest", manifest);
+
+    // The id pass times the same files as the string pass.
+    static constexpr AssetId RESOLVE_IDS[] = {
+        TitleResources::BACKGROUND_SKY,
+        TitleResources::BACKGROUND_ISLAND,
+        TitleResources::BACKGROUND_DEATHEGG,
+        TitleResources::WIPE,
+        "SONICORCA/ENGINE/SONIC.png"_asset,
+        TitleResources::FONT,
+    };
+    std::vector<std::string> paths;
+    for (const AssetId& id : RESOLVE_IDS) {
+        paths.push_back(id.GetPath());
+    }
+
+    size_t length = 0;
+    Bench::Stats resolve = Bench::Measure([&]() {
+        for (const auto& path : paths) {
+            length += mods.Resolve(path).size();
+        }
+    }, 31, 256);
+    Bench::ReportRate("mods/resolve", resolve, static_cast<double>(paths.size()), "paths");
+
+    Bench::Stats resolveIds = Bench::Measure([&]() {
+        for (const AssetId& id : RESOLVE_IDS) {
+            length += mods.Resolve(id).size();
+        }
+    }, 31, 256);
+    Bench::ReportRate("mods/resolve-id", resolveIds, static_cast<double>(std::size(RESOLVE_IDS)), "paths");
+
+    // Title IDs are looked up in ModIndex and loaded from data/SONICORCA/;
+    // both must name the same file, or overrides are silently missed.
+    bool agree = true;
+    for (const AssetId& asset : TitleResources::GetAllResources()) {
+        std::string expected = "data/" + std::string(asset.GetPath());
+        std::string resolved = mods.Resolve(asset);
+        bool same = expected == DATA_DIRECTORY + asset.GetSonicOrcaPath() && resolved.size() >= expected.size() &&
+                    resolved.compare(resolved.size() - expected.size(), expected.size(), expected) == 0;
+        if (!same) {
+            std::printf("%-40s %s resolves to %s\n", "mods/ids", asset.GetPath(), resolved.c_str());
+            agree = false;
+        }
+    }
+    std::printf("%-40s %s\n", "mods/ids/agree", agree ? "yes" : "NO");
+}
@@ -0,0 +1,233 @@
+#include "AudioMixer.hpp"
+#include "core/MemoryRegistry.hpp"
+#include <SDL2/SDL_mixer.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const char* const DATA_DIRECTORY = "data/SONICORCA/";
+    const char* const SOUND_EXTENSIONS[] = {".ogg", ".wav"};
+
+    int16_t ToGain(float gain) {
+        return static_cast<int16_t>(std::clamp(gain, 0.0f, 1.0f) * 256.0f);
+    }
+}
+
+AudioMixer& AudioMixer::GetInstance() {
+    static AudioMixer instance;
+    return instance;
+}
+
+AudioMixer::~AudioMixer() {
+    Shutdown();
+}
+
+bool AudioMixer::Initialize(int frequency, int bufferFrames) {
+    if (initialized_) return true;
+
+    // Share the device if something already opened it through SDL_mixer.
+    Uint16 format = 0;
+    if (!Mix_QuerySpec(&frequency_, &format, &channels_)) {
+        if (Mix_OpenAudio(frequency, AUDIO_S16SYS, 2, bufferFrames) < 0) {
+            std::cerr << "Failed to open audio device: " << Mix_GetError() << std::endl;
+            return false;
+        }
+        ownsDevice_ = true;
+        Mix_QuerySpec(&frequency_, &format, &channels_);
+    }
+
+    if (format != AUDIO_S16SYS || channels_ < 1 || channels_ > 2) {
+        std::cerr << "Unsupported audio device format" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    music_.Start(frequency_, channels_);
+    Mix_SetPostMix(&AudioMixer::PostMix, this);
+    initialized_ = true;
+    return true;
+}
+
+void AudioMixer::Shutdown() {
+    if (initialized_) {
+        // Mix_SetPostMix takes the audio lock, so the callback is gone after this.
+        Mix_SetPostMix(nullptr, nullptr);
+        initialized_ = false;
+    }
+    music_.Stop();
+    if (ownsDevice_) {
+        Mix_CloseAudio();
+        ownsDevice_ = false;
+    }
+
+    Command command;
+    while (commands_.Pop(command)) {}
+    voices_ = {};
+    sounds_.clear();
+    MemoryRegistry::GetInstance().UntrackOwner(MEMORY_OWNER);
+}
+
+int AudioMixer::LoadSound(const std::string& name) {
+    return LoadSound(name, AssetId::Hash(std::string(AssetId::SONICORCA_ROOT) + name));
+}
+
+int AudioMixer::LoadSound(const AssetId& name) {
+    return LoadSound(name.GetSonicOrcaPath(), name.GetValue());
+}
+
+int AudioMixer::LoadSound(const std::string& name, uint64_t id) {
+    if (!initialized_) return -1;
+
+    for (size_t i = 0; i < sounds_.size(); i++) {
+        if (sounds_[i].id == id) return static_cast<int>(i);
+    }
+
+    Mix_Chunk* chunk = nullptr;
+    std::string path = DATA_DIRECTORY + name;
+    if (name.find('.') != std::string::npos) {
+        chunk = Mix_LoadWAV(path.c_str());
+    } else {
+        for (const char* extension : SOUND_EXTENSIONS) {
+            chunk = Mix_LoadWAV((path + extension).c_str());
+            if (chunk) break;
+        }
+    }
+
+    if (!chunk) {
+        std::cerr << "Failed to load sound: " << name << std::endl;
+        return -1;
+    }
+
+    // Mix_LoadWAV already converted to the device format; keep our own copy
+    // so the chunk can go and the voices read straight from the pool.
+    Sound sound;
+    sound.id = id;
+    AssetId::RegisterName(id, std::string(AssetId::SONICORCA_ROOT) + name);
+    sound.frames = chunk->alen / (sizeof(int16_t) * channels_);
+    sound.samples = std::make_unique<int16_t[]>(static_cast<size_t>(sound.frames) * channels_);
+    std::memcpy(sound.samples.get(), chunk->abuf, static_cast<size_t>(sound.frames) * channels_ * sizeof(int16_t));
+    Mix_FreeChunk(chunk);
+
+    MemoryRegistry::GetInstance().Track(sound.samples.get(), ResourceKind::Audio, MEMORY_OWNER, name,
+                                        static_cast<size_t>(sound.frames) * channels_ * sizeof(int16_t));
+    sounds_.push_back(std::move(sound));
+    return static_cast<int>(sounds_.size()) - 1;
+}
+
+void AudioMixer::Play(int sound, float volume, float pan) {
+    if (!initialized_ || sound < 0 || sound >= static_cast<int>(sounds_.size())) return;
+
+    Command command;
+    command.type = CommandType::Play;
+    command.sound = sound;
+    command.samples = sounds_[sound].samples.get();
+    command.frames = sounds_[sound].frames;
+    command.gainLeft = ToGain(volume * std::min(1.0f, 1.0f - pan));
+    command.gainRight = ToGain(volume * std::min(1.0f, 1.0f + pan));
+    if (!commands_.Push(command)) {
+        std::cerr << "Audio command queue full, dropped " << AssetId::GetName(sounds_[sound].id) << std::endl;
+    }
+}
+
+void AudioMixer::Stop(int sound) {
+    if (!initialized_) return;
+
+    Command command;
+    command.type = CommandType::Stop;
+    command.sound = sound;
+    commands_.Push(command);
+}
+
+void AudioMixer::StopAll() {
+    if (!initialized_) return;
+
+    Command command;
+    command.type = CommandType::StopAll;
+    commands_.Push(command);
+}
+
+void AudioMixer::PostMix(void* userdata, Uint8* stream, int length) {
+    auto* mixer = static_cast<AudioMixer*>(userdata);
+    mixer->ProcessCommands();
+    mixer->Mix(reinterpret_cast<int16_t*>(stream), length / static_cast<int>(sizeof(int16_t) * mixer->channels_));
+}
+
+void AudioMixer::ProcessCommands() {
+    Command command;
+    while (commands_.Pop(command)) {
+        switch (command.type) {
+            case CommandType::Play: {
+                // Take a free voice, or steal the one closest to finishing.
+                Voice* target = &voices_[0];
+                uint32_t bestRemaining = UINT32_MAX;
+                for (auto& voice : voices_) {
+                    if (!voice.samples) { target = &voice; break; }
+                    uint32_t remaining = voice.frames - voice.position;
+                    if (remaining < bestRemaining) {
+                        bestRemaining = remaining;
+                        target = &voice;
+                    }
+                }
+                target->samples = command.samples;
+                target->frames = command.frames;
+                target->position = 0;
+                target->sound = command.sound;
+                target->gainLeft = command.gainLeft;
+                target->gainRight = command.gainRight;
+                break;
+            }
+            case CommandType::Stop:
+                for (auto& voice : voices_) {
+                    if (voice.sound == command.sound) voice.samples = nullptr;
+                }
+                break;
+            case CommandType::StopAll:
+                for (auto& voice : voices_) {
+                    voice.samples = nullptr;
+                }
+                break;
+        }
+    }
+}
+
+void AudioMixer::Mix(int16_t* output, int frames) {
+    while (frames > 0) {
+        int chunk = std::min(frames, MIX_CHUNK_FRAMES);
+        int samples = chunk * channels_;
+        for (int i = 0; i < samples; i++) {
+            accumulator_[i] = static_cast<int32_t>(output[i]) << 8;
+        }
+        music_.Mix(accumulator_.data(), chunk);
+
+        for (auto& voice : voices_) {
+            if (!voice.samples) continue;
+
+            int count = static_cast<int>(std::min<uint32_t>(chunk, voice.frames - voice.position));
+            const int16_t* source = voice.samples + static_cast<size_t>(voice.position) * channels_;
+            if (channels_ == 2) {
+                for (int i = 0; i < count; i++) {
+                    accumulator_[i * 2] += source[i * 2] * voice.gainLeft;
+                    accumulator_[i * 2 + 1] += source[i * 2 + 1] * voice.gainRight;
+                }
+            } else {
+                int32_t gain = (voice.gainLeft + voice.gainRight) >> 1;
+                for (int i = 0; i < count; i++) {
+                    accumulator_[i] += source[i] * gain;
+                }
+            }
+
+            voice.position += count;
+            if (voice.position >= voice.frames) {
+                voice.samples = nullptr;
+            }
+        }
+
+        for (int i = 0; i < samples; i++) {
+            output[i] = static_cast<int16_t>(std::clamp(accumulator_[i] >> 8, -32768, 32767));
+        }
+
+        output += samples;
+        frames -= chunk;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "MusicPlayer.hpp"
+#include "core/SpscQueue.hpp"
+#include "resources/AssetId.hpp"
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Sound effects decoded once to 16-bit PCM at the device rate and mixed from
+// a fixed voice pool inside SDL_mixer's post-mix callback. The game thread
+// only talks to the audio thread through a lock-free command queue, so the
+// callback never locks or allocates.
+class AudioMixer {
+public:
+    static AudioMixer& GetInstance();
+
+    bool Initialize(int frequency = DEFAULT_FREQUENCY, int bufferFrames = DEFAULT_BUFFER_FRAMES);
+    void Shutdown();
+
+    int LoadSound(const std::string& name);
+    int LoadSound(const AssetId& name);
+    void Play(int sound, float volume = 1.0f, float pan = 0.0f);
+    void Stop(int sound);
+    void StopAll();
+
+    MusicPlayer& GetMusic() { return music_; }
+
+    int GetFrequency() const { return frequency_; }
+    int GetChannels() const { return channels_; }
+
+    static constexpr int DEFAULT_FREQUENCY = 48000;
+    static constexpr int DEFAULT_BUFFER_FRAMES = 256;
+    static constexpr int MAX_VOICES = 24;
+    static constexpr const char* MEMORY_OWNER = "Audio";
+
+private:
+    AudioMixer() = default;
+    ~AudioMixer();
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    static constexpr int MIX_CHUNK_FRAMES = 512;
+
+    int LoadSound(const std::string& name, uint64_t id);
+
+    struct Sound {
+        std::unique_ptr<int16_t[]> samples;
+        uint32_t frames = 0;
+        uint64_t id = 0;
+    };
+
+    enum class CommandType : uint8_t {
+        Play,
+        Stop,
+        StopAll
+    };
+
+    struct Command {
+        CommandType type = CommandType::Play;
+        int sound = -1;
+        const int16_t* samples = nullptr;
+        uint32_t frames = 0;
+        int16_t gainLeft = 0;
+        int16_t gainRight = 0;
+    };
+
+    struct Voice {
+        const int16_t* samples = nullptr;
+        uint32_t frames = 0;
+        uint32_t position = 0;
+        int sound = -1;
+        int32_t gainLeft = 0;
+        int32_t gainRight = 0;
+    };
+
+    static void PostMix(void* userdata, Uint8* stream, int length);
+    void ProcessCommands();
+    void Mix(int16_t* output, int frames);
+
+    std::vector<Sound> sounds_;
+    MusicPlayer music_;
+    SpscQueue<Command, 256> commands_;
+    std::array<Voice, MAX_VOICES> voices_;
+    std::array<int32_t, MIX_CHUNK_FRAMES * 2> accumulator_;
+
+    int frequency_ = 0;
+    int channels_ = 0;
+    bool initialized_ = false;
+    bool ownsDevice_ = false;
+};
@@ -0,0 +1,418 @@
+#include "MusicPlayer.hpp"
+#include "AudioMixer.hpp"
+#include "core/MemoryRegistry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const char* const DATA_DIRECTORY = "data/SONICORCA/";
+    const char* const FALLBACK_EXTENSIONS[] = {".ogg", ".mp3", ".flac"};
+    constexpr int32_t FULL_GAIN = 1 << 16;
+
+    uint32_t ReadU32(const char* data) {
+        return static_cast<uint8_t>(data[0]) | (static_cast<uint8_t>(data[1]) << 8) |
+               (static_cast<uint8_t>(data[2]) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(data[3])) << 24);
+    }
+
+    uint16_t ReadU16(const char* data) {
+        return static_cast<uint16_t>(static_cast<uint8_t>(data[0]) | (static_cast<uint8_t>(data[1]) << 8));
+    }
+
+    bool FileExists(const std::string& path) {
+        return std::ifstream(path).good();
+    }
+}
+
+MusicPlayer::~MusicPlayer() {
+    Stop();
+}
+
+bool MusicPlayer::Start(int frequency, int channels) {
+    if (running_) return true;
+
+    frequency_ = frequency;
+    channels_ = channels;
+    for (auto& track : tracks_) {
+        track.ring = std::make_unique<int16_t[]>(static_cast<size_t>(RING_FRAMES) * channels_);
+        MemoryRegistry::GetInstance().Track(track.ring.get(), ResourceKind::Audio, AudioMixer::MEMORY_OWNER,
+                                            "music ring", static_cast<size_t>(RING_FRAMES) * channels_ * sizeof(int16_t));
+    }
+    decodeBuffer_.resize(static_cast<size_t>(DECODE_FRAMES) * 2);
+    convertBuffer_.resize(static_cast<size_t>(DECODE_FRAMES) * channels_);
+
+    running_ = true;
+    worker_ = std::thread(&MusicPlayer::WorkerLoop, this);
+    return true;
+}
+
+void MusicPlayer::Stop() {
+    if (running_) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        wake_.notify_all();
+        worker_.join();
+    }
+
+    StopFallback(0);
+    for (auto& track : tracks_) {
+        CloseTrack(track);
+        track.active = false;
+    }
+    current_ = -1;
+}
+
+void MusicPlayer::Play(const std::string& name, int64_t loopStart, int64_t loopEnd, int fadeFrames) {
+    if (!running_) return;
+
+    std::string path = DATA_DIRECTORY + name;
+    if (name.find('.') == std::string::npos) {
+        path += ".wav";
+    }
+
+    // Anything other than PCM WAV goes through SDL_mixer's own streaming,
+    // which cannot honour loop points.
+    if (path.size() < 4 || path.compare(path.size() - 4, 4, ".wav") != 0 || !FileExists(path)) {
+        if (PlayFallback(name, fadeFrames)) {
+            FadeOutStream(fadeFrames);
+        }
+        return;
+    }
+
+    StopFallback(fadeFrames);
+
+    Request request;
+    request.name = path;
+    request.loopStart = loopStart;
+    request.loopEnd = loopEnd;
+    request.fadeFrames = fadeFrames;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.push_back(request);
+    }
+    wake_.notify_one();
+}
+
+void MusicPlayer::FadeOut(int fadeFrames) {
+    StopFallback(fadeFrames);
+    FadeOutStream(fadeFrames);
+}
+
+void MusicPlayer::FadeOutStream(int fadeFrames) {
+    if (!running_) return;
+
+    Request request;
+    request.stop = true;
+    request.fadeFrames = fadeFrames;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.push_back(request);
+    }
+    wake_.notify_one();
+}
+
+void MusicPlayer::WorkerLoop() {
+    std::vector<Request> requests;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, std::chrono::milliseconds(5), [this]() { return !running_ || !requests_.empty(); });
+            if (!running_) break;
+            requests.swap(requests_);
+        }
+
+        for (const auto& request : requests) {
+            HandleRequest(request);
+        }
+        requests.clear();
+
+        for (auto& track : tracks_) {
+            if (track.decoding) FillTrack(track);
+        }
+    }
+}
+
+void MusicPlayer::HandleRequest(const Request& request) {
+    if (request.stop) {
+        if (current_ >= 0) {
+            commands_.Push({CommandType::FadeOut, current_, request.fadeFrames});
+            current_ = -1;
+        }
+        return;
+    }
+
+    int next = current_ == 0 ? 1 : 0;
+    Track& track = tracks_[next];
+
+    // The slot may still be fading out from an earlier switch; cut it so it
+    // can be reused. The audio thread clears the flag on its next callback.
+    if (track.active) {
+        commands_.Push({CommandType::Stop, next, 0});
+        for (int i = 0; i < 200 && track.active && running_; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (track.active) return;
+    }
+
+    CloseTrack(track);
+    if (!OpenTrack(track, request.name, request.loopStart, request.loopEnd)) {
+        return;
+    }
+    FillTrack(track);
+
+    // The gain is set before the callback may read the ring; an active track
+    // without its FadeIn would play out its first frames at gain 0. If the
+    // queue is full the old track keeps playing.
+    if (!commands_.Push({CommandType::FadeIn, next, request.fadeFrames})) {
+        std::cerr << "Music command queue full, not starting: " << request.name << std::endl;
+        CloseTrack(track);
+        return;
+    }
+    track.active.store(true, std::memory_order_release);
+
+    if (current_ >= 0) {
+        commands_.Push({CommandType::FadeOut, current_, request.fadeFrames});
+    }
+    current_ = next;
+}
+
+bool MusicPlayer::OpenTrack(Track& track, const std::string& path, int64_t loopStart, int64_t loopEnd) {
+    track.file.open(path, std::ios::binary);
+    if (!track.file.is_open()) {
+        std::cerr << "Failed to open music: " << path << std::endl;
+        return false;
+    }
+
+    char header[12];
+    if (!track.file.read(header, 12) || std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0) {
+        std::cerr << "Invalid music file: " << path << std::endl;
+        CloseTrack(track);
+        return false;
+    }
+
+    int sampleRate = 0;
+    int bitsPerSample = 0;
+    uint16_t formatTag = 0;
+    int64_t fileLoopStart = -1;
+    int64_t fileLoopEnd = -1;
+    uint32_t dataSize = 0;
+    track.dataOffset = 0;
+    track.sourceChannels = 0;
+
+    char chunk[8];
+    while (track.file.read(chunk, 8)) {
+        uint32_t size = ReadU32(chunk + 4);
+        std::streamoff start = track.file.tellg();
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            char format[16];
+            track.file.read(format, 16);
+            formatTag = ReadU16(format);
+            track.sourceChannels = ReadU16(format + 2);
+            sampleRate = static_cast<int>(ReadU32(format + 4));
+            bitsPerSample = ReadU16(format + 14);
+        } else if (std::memcmp(chunk, "smpl", 4) == 0 && size >= 60) {
+            char sampler[60];
+            track.file.read(sampler, 60);
+            if (ReadU32(sampler + 28) > 0) {
+                fileLoopStart = ReadU32(sampler + 44);
+                fileLoopEnd = static_cast<int64_t>(ReadU32(sampler + 48)) + 1;
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            track.dataOffset = start;
+            dataSize = size;
+        }
+
+        track.file.clear();
+        track.file.seekg(start + size + (size & 1));
+    }
+    track.file.clear();
+
+    if (formatTag != 1 || bitsPerSample != 16 || track.sourceChannels < 1 || track.sourceChannels > 2 ||
+        sampleRate <= 0 || track.dataOffset == 0) {
+        std::cerr << "Unsupported music format (16-bit PCM WAV expected): " << path << std::endl;
+        CloseTrack(track);
+        return false;
+    }
+
+    track.totalFrames = dataSize / (2 * track.sourceChannels);
+    track.loopStart = loopStart >= 0 ? loopStart : std::max<int64_t>(fileLoopStart, 0);
+    track.loopEnd = loopEnd >= 0 ? loopEnd : (fileLoopEnd > 0 ? fileLoopEnd : track.totalFrames);
+    track.loopEnd = std::min(track.loopEnd, track.totalFrames);
+    if (track.loopStart >= track.loopEnd) {
+        track.loopStart = 0;
+        track.loopEnd = track.totalFrames;
+    }
+
+    track.stream = SDL_NewAudioStream(AUDIO_S16SYS, static_cast<Uint8>(track.sourceChannels), sampleRate,
+                                      AUDIO_S16SYS, static_cast<Uint8>(channels_), frequency_);
+    if (!track.stream) {
+        std::cerr << "Failed to create music stream: " << SDL_GetError() << std::endl;
+        CloseTrack(track);
+        return false;
+    }
+
+    track.file.seekg(track.dataOffset);
+    track.position = 0;
+    track.writeFrame = 0;
+    track.readFrame = 0;
+    track.decoding = true;
+    return true;
+}
+
+void MusicPlayer::CloseTrack(Track& track) {
+    if (track.stream) {
+        SDL_FreeAudioStream(track.stream);
+        track.stream = nullptr;
+    }
+    if (track.file.is_open()) {
+        track.file.close();
+    }
+    track.file.clear();
+    track.decoding = false;
+}
+
+void MusicPlayer::FillTrack(Track& track) {
+    const int frameBytes = static_cast<int>(sizeof(int16_t)) * channels_;
+
+    while (true) {
+        uint32_t write = track.writeFrame.load(std::memory_order_relaxed);
+        uint32_t space = RING_FRAMES - (write - track.readFrame.load(std::memory_order_acquire));
+        if (space == 0) break;
+
+        if (SDL_AudioStreamAvailable(track.stream) < frameBytes) {
+            if (!track.decoding) break;
+
+            // Wrapping here, in source frames, keeps the loop sample-accurate
+            // and lets the resampler see one continuous signal.
+            int64_t frames = std::min<int64_t>(DECODE_FRAMES, track.loopEnd - track.position);
+            if (frames <= 0) {
+                track.position = track.loopStart;
+                track.file.clear();
+                track.file.seekg(track.dataOffset + track.position * 2 * track.sourceChannels);
+                continue;
+            }
+
+            std::streamsize bytes = static_cast<std::streamsize>(frames * 2 * track.sourceChannels);
+            track.file.read(reinterpret_cast<char*>(decodeBuffer_.data()), bytes);
+            std::streamsize got = track.file.gcount();
+            if (got <= 0) {
+                SDL_AudioStreamFlush(track.stream);
+                track.decoding = false;
+                continue;
+            }
+            SDL_AudioStreamPut(track.stream, decodeBuffer_.data(), static_cast<int>(got));
+            track.position += got / (2 * track.sourceChannels);
+            continue;
+        }
+
+        int wanted = std::min<int>(static_cast<int>(space), DECODE_FRAMES) * frameBytes;
+        int got = SDL_AudioStreamGet(track.stream, convertBuffer_.data(), wanted);
+        if (got <= 0) break;
+
+        int frames = got / frameBytes;
+        for (int i = 0; i < frames; i++) {
+            int16_t* dest = &track.ring[static_cast<size_t>((write + i) & (RING_FRAMES - 1)) * channels_];
+            std::memcpy(dest, &convertBuffer_[static_cast<size_t>(i) * channels_], frameBytes);
+        }
+        track.writeFrame.store(write + frames, std::memory_order_release);
+    }
+}
+
+bool MusicPlayer::PlayFallback(const std::string& name, int fadeFrames) {
+    std::string path = DATA_DIRECTORY + name;
+    Mix_Music* music = nullptr;
+    if (name.find('.') != std::string::npos) {
+        music = Mix_LoadMUS(path.c_str());
+    } else {
+        for (const char* extension : FALLBACK_EXTENSIONS) {
+            music = Mix_LoadMUS((path + extension).c_str());
+            if (music) break;
+        }
+    }
+
+    if (!music) {
+        std::cerr << "Failed to load music: " << name << std::endl;
+        return false;
+    }
+
+    StopFallback(0);
+    fallback_ = music;
+    Mix_FadeInMusic(fallback_, -1, fadeFrames * 1000 / std::max(frequency_, 1));
+    return true;
+}
+
+void MusicPlayer::StopFallback(int fadeFrames) {
+    // Freeing music that is still fading blocks until the fade ends, so a
+    // faded track is parked and freed once SDL_mixer has finished with it.
+    if (retiredFallback_ && (!Mix_PlayingMusic() || fadeFrames <= 0)) {
+        Mix_HaltMusic();
+        Mix_FreeMusic(retiredFallback_);
+        retiredFallback_ = nullptr;
+    }
+    if (!fallback_) return;
+
+    int fadeMs = fadeFrames * 1000 / std::max(frequency_, 1);
+    if (fadeMs > 0 && !retiredFallback_ && Mix_PlayingMusic()) {
+        Mix_FadeOutMusic(fadeMs);
+        retiredFallback_ = fallback_;
+    } else {
+        Mix_HaltMusic();
+        Mix_FreeMusic(fallback_);
+    }
+    fallback_ = nullptr;
+}
+
+void MusicPlayer::ProcessCommands() {
+    Command command;
+    while (commands_.Pop(command)) {
+        Track& track = tracks_[command.track];
+        int fadeFrames = std::max(command.fadeFrames, 1);
+        switch (command.type) {
+            case CommandType::FadeIn:
+                track.gain = command.fadeFrames > 0 ? 0 : FULL_GAIN;
+                track.gainStep = FULL_GAIN / fadeFrames;
+                break;
+            case CommandType::FadeOut:
+                track.gainStep = -std::max(track.gain / fadeFrames, 1);
+                break;
+            case CommandType::Stop:
+                track.gain = 0;
+                track.gainStep = 0;
+                track.active.store(false, std::memory_order_release);
+                break;
+        }
+    }
+}
+
+void MusicPlayer::Mix(int32_t* accumulator, int frames) {
+    ProcessCommands();
+
+    for (auto& track : tracks_) {
+        if (!track.active.load(std::memory_order_acquire)) continue;
+
+        uint32_t read = track.readFrame.load(std::memory_order_relaxed);
+        uint32_t available = track.writeFrame.load(std::memory_order_acquire) - read;
+        int count = static_cast<int>(std::min<uint32_t>(available, static_cast<uint32_t>(frames)));
+
+        int32_t gain = track.gain;
+        int32_t step = track.gainStep;
+        for (int i = 0; i < count; i++) {
+            gain = std::clamp(gain + step, 0, FULL_GAIN);
+            const int16_t* source = &track.ring[static_cast<size_t>((read + i) & (RING_FRAMES - 1)) * channels_];
+            for (int c = 0; c < channels_; c++) {
+                accumulator[i * channels_ + c] += source[c] * (gain >> 8);
+            }
+        }
+        track.gain = gain;
+        track.readFrame.store(read + count, std::memory_order_release);
+
+        if (step < 0 && (gain == 0 || count == 0)) {
+            track.gainStep = 0;
+            track.active.store(false, std::memory_order_release);
+        }
+    }
+}
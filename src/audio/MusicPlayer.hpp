@@ -0,0 +1,112 @@
+#pragma once
+
+#include "core/SpscQueue.hpp"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Streams music from disk through a fixed-size ring per track, so memory use
+// does not depend on track length. A worker thread decodes ahead and wraps at
+// the loop points in source samples; the audio callback only reads the rings
+// and ramps gains, which is also how tracks crossfade.
+class MusicPlayer {
+public:
+    MusicPlayer() = default;
+    ~MusicPlayer();
+
+    MusicPlayer(const MusicPlayer&) = delete;
+    MusicPlayer& operator=(const MusicPlayer&) = delete;
+
+    bool Start(int frequency, int channels);
+    void Stop();
+
+    // Loop points are in source sample frames. Negative values use the loop
+    // stored in the file's smpl chunk, or the whole track without one.
+    void Play(const std::string& name, int64_t loopStart = -1, int64_t loopEnd = -1, int fadeFrames = 0);
+    void FadeOut(int fadeFrames);
+
+    // Audio thread only. Adds into a mix accumulator scaled by 256.
+    void Mix(int32_t* accumulator, int frames);
+
+    static constexpr int RING_FRAMES = 16384;
+    static constexpr int DECODE_FRAMES = 2048;
+
+private:
+    enum class CommandType : uint8_t {
+        FadeIn,
+        FadeOut,
+        Stop
+    };
+
+    struct Command {
+        CommandType type = CommandType::Stop;
+        int track = 0;
+        int fadeFrames = 0;
+    };
+
+    struct Request {
+        std::string name;
+        int64_t loopStart = -1;
+        int64_t loopEnd = -1;
+        int fadeFrames = 0;
+        bool stop = false;
+    };
+
+    struct Track {
+        // Worker thread.
+        std::ifstream file;
+        SDL_AudioStream* stream = nullptr;
+        int sourceChannels = 0;
+        std::streamoff dataOffset = 0;
+        int64_t totalFrames = 0;
+        int64_t loopStart = 0;
+        int64_t loopEnd = 0;
+        int64_t position = 0;
+        bool decoding = false;
+
+        // Shared between the worker and the audio thread.
+        std::unique_ptr<int16_t[]> ring;
+        std::atomic<uint32_t> writeFrame{0};
+        std::atomic<uint32_t> readFrame{0};
+        std::atomic<bool> active{false};
+
+        // Audio thread, Q16 gain.
+        int32_t gain = 0;
+        int32_t gainStep = 0;
+    };
+
+    void FadeOutStream(int fadeFrames);
+    void WorkerLoop();
+    void HandleRequest(const Request& request);
+    bool OpenTrack(Track& track, const std::string& path, int64_t loopStart, int64_t loopEnd);
+    void CloseTrack(Track& track);
+    void FillTrack(Track& track);
+    bool PlayFallback(const std::string& name, int fadeFrames);
+    void StopFallback(int fadeFrames);
+    void ProcessCommands();
+
+    std::array<Track, 2> tracks_;
+    int current_ = -1;
+    int frequency_ = 0;
+    int channels_ = 0;
+    std::vector<int16_t> decodeBuffer_;
+    std::vector<int16_t> convertBuffer_;
+    Mix_Music* fallback_ = nullptr;
+    Mix_Music* retiredFallback_ = nullptr;
+
+    SpscQueue<Command, 16> commands_;
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Request> requests_;
+    std::atomic<bool> running_{false};
+};
@@ -0,0 +1,169 @@
+#include "HitchDetector.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    double Milliseconds(HitchDetector::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    void PrintEvent(const char* name, const std::string& detail, double milliseconds, size_t bytes) {
+        std::cerr << "    " << std::setw(10) << name << " " << detail;
+        if (milliseconds > 0.0) std::cerr << " " << milliseconds << "ms";
+        if (bytes > 0) std::cerr << " " << bytes / 1024 << "KB";
+        std::cerr << std::endl;
+    }
+}
+
+HitchDetector::Scope::Scope(HitchEvent kind, std::string detail)
+    : kind_(kind)
+    , detail_(std::move(detail))
+    , start_(Clock::now())
+{}
+
+HitchDetector::Scope::~Scope() {
+    HitchDetector::GetInstance().Record(kind_, detail_, Milliseconds(Clock::now() - start_));
+}
+
+HitchDetector& HitchDetector::GetInstance() {
+    static HitchDetector instance;
+    return instance;
+}
+
+void HitchDetector::Install() {
+    mainThread_ = std::this_thread::get_id();
+    installed_ = true;
+    events_.reserve(64);
+
+    const char* budget = SDL_getenv("S2HDPP_HITCH_BUDGET_MS");
+    if (budget) {
+        SetBudget(std::atof(budget));
+    }
+}
+
+bool HitchDetector::IsMainThread() const {
+    return installed_ && std::this_thread::get_id() == mainThread_;
+}
+
+void HitchDetector::MarkFrame() {
+    if (!IsMainThread()) return;
+
+    Clock::time_point now = Clock::now();
+    if (started_ && !ignoreFrame_) {
+        double frameMs = Milliseconds(now - lastFrame_);
+        history_[frames_ % HISTORY_FRAMES] = static_cast<float>(frameMs);
+        frames_++;
+        if (frameMs > budgetMs_) {
+            OnHitch(frameMs);
+        }
+    }
+
+    events_.clear();
+    ignoreFrame_ = false;
+    lastFrame_ = now;
+    started_ = true;
+}
+
+void HitchDetector::Record(HitchEvent kind, const std::string& detail, double milliseconds, size_t bytes) {
+    if (!IsMainThread()) return;
+    events_.push_back({kind, detail, milliseconds, bytes});
+}
+
+void HitchDetector::RecordAllocation(const std::string& detail, size_t bytes) {
+    if (bytes < LARGE_ALLOCATION_BYTES) return;
+    Record(HitchEvent::Allocation, detail, 0.0, bytes);
+}
+
+void HitchDetector::OnHitch(double frameMs) {
+    hitches_++;
+
+    std::streamsize precision = std::cerr.precision();
+    std::cerr << std::fixed << std::setprecision(1)
+              << "Hitch: frame " << frames_ << " took " << frameMs << "ms (budget " << budgetMs_ << "ms)";
+    if (events_.empty()) {
+        std::cerr << ", nothing recorded" << std::endl;
+    } else {
+        std::cerr << std::endl;
+        for (const auto& event : events_) {
+            PrintEvent(GetEventName(event.kind), event.detail, event.milliseconds, event.bytes);
+        }
+    }
+    std::cerr.unsetf(std::ios::floatfield);
+    std::cerr.precision(precision);
+
+    for (const auto& event : events_) {
+        Culprit& culprit = culprits_[{event.kind, event.detail}];
+        culprit.hitches++;
+        culprit.totalMs += event.milliseconds;
+        culprit.worstFrameMs = std::max(culprit.worstFrameMs, frameMs);
+        culprit.bytes = std::max(culprit.bytes, event.bytes);
+    }
+
+    // Keep the worst frames with their events for the exit report.
+    auto slowest = [](const Hitch& a, const Hitch& b) { return a.milliseconds > b.milliseconds; };
+    if (worst_.size() < WORST_FRAMES || frameMs > worst_.back().milliseconds) {
+        if (worst_.size() >= WORST_FRAMES) worst_.pop_back();
+        worst_.push_back({frames_, frameMs, events_});
+        std::sort(worst_.begin(), worst_.end(), slowest);
+    }
+}
+
+void HitchDetector::Report() const {
+    if (frames_ == 0) return;
+
+    size_t count = std::min<size_t>(frames_, HISTORY_FRAMES);
+    std::vector<float> recent(history_.begin(), history_.begin() + count);
+    std::sort(recent.begin(), recent.end());
+
+    std::streamsize precision = std::cerr.precision();
+    std::cerr << std::fixed << std::setprecision(1)
+              << "Hitch report: " << hitches_ << " of " << frames_ << " frames over " << budgetMs_ << "ms"
+              << " (last " << count << " frames: median " << recent[count / 2]
+              << "ms, p99 " << recent[std::min(count - 1, count * 99 / 100)]
+              << "ms, max " << recent.back() << "ms)" << std::endl;
+
+    if (hitches_ > 0) {
+        // Rank by the load time spent inside slow frames, so the asset or
+        // transition worth fixing first comes out on top.
+        std::vector<std::pair<std::pair<HitchEvent, std::string>, Culprit>> ranked(culprits_.begin(), culprits_.end());
+        std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+            if (a.second.totalMs != b.second.totalMs) return a.second.totalMs > b.second.totalMs;
+            return a.second.hitches > b.second.hitches;
+        });
+
+        std::cerr << "  Culprits (time in slow frames, hitches, worst frame):" << std::endl;
+        for (size_t i = 0; i < ranked.size() && i < REPORT_ENTRIES; i++) {
+            const Culprit& culprit = ranked[i].second;
+            std::cerr << "  " << std::setw(2) << i + 1 << ". " << std::setw(10) << GetEventName(ranked[i].first.first)
+                      << " " << ranked[i].first.second << "  " << culprit.totalMs << "ms, " << culprit.hitches
+                      << "x, " << culprit.worstFrameMs << "ms";
+            if (culprit.bytes > 0) std::cerr << ", " << culprit.bytes / 1024 << "KB";
+            std::cerr << std::endl;
+        }
+
+        std::cerr << "  Worst frames:" << std::endl;
+        for (const auto& hitch : worst_) {
+            std::cerr << "  frame " << hitch.frame << ": " << hitch.milliseconds << "ms" << std::endl;
+            for (const auto& event : hitch.events) {
+                PrintEvent(GetEventName(event.kind), event.detail, event.milliseconds, event.bytes);
+            }
+        }
+    }
+
+    std::cerr.unsetf(std::ios::floatfield);
+    std::cerr.precision(precision);
+}
+
+const char* HitchDetector::GetEventName(HitchEvent kind) {
+    switch (kind) {
+        case HitchEvent::Texture: return "texture";
+        case HitchEvent::Image: return "image";
+        case HitchEvent::Font: return "font";
+        case HitchEvent::Transition: return "transition";
+        case HitchEvent::Allocation: return "allocation";
+    }
+    return "unknown";
+}
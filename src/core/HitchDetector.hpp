@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class HitchEvent {
+    Texture,
+    Image,
+    Font,
+    Transition,
+    Allocation
+};
+
+// Keeps a rolling history of frame times on the main thread and remembers
+// what was loaded, allocated or switched during the current frame. When a
+// frame runs over budget those events are logged and added to a ranking that
+// Report prints at exit. Events from other threads cannot stall a frame and
+// are ignored.
+class HitchDetector {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class Scope {
+    public:
+        Scope(HitchEvent kind, std::string detail);
+        ~Scope();
+
+    private:
+        HitchEvent kind_;
+        std::string detail_;
+        Clock::time_point start_;
+    };
+
+    static HitchDetector& GetInstance();
+
+    // Call on the main thread before any other thread records events.
+    void Install();
+    void MarkFrame();
+    // The current frame is being stretched on purpose and is not a hitch.
+    void IgnoreFrame() { ignoreFrame_ = true; }
+
+    void Record(HitchEvent kind, const std::string& detail, double milliseconds, size_t bytes = 0);
+    void RecordAllocation(const std::string& detail, size_t bytes);
+
+    void SetBudget(double milliseconds) { if (milliseconds > 0.0) budgetMs_ = milliseconds; }
+    double GetBudget() const { return budgetMs_; }
+    void Report() const;
+
+    static const char* GetEventName(HitchEvent kind);
+
+    static constexpr double DEFAULT_BUDGET_MS = 25.0;
+    static constexpr size_t HISTORY_FRAMES = 600;
+    static constexpr size_t LARGE_ALLOCATION_BYTES = 1024 * 1024;
+    static constexpr size_t WORST_FRAMES = 10;
+    static constexpr size_t REPORT_ENTRIES = 20;
+
+private:
+    HitchDetector() = default;
+    HitchDetector(const HitchDetector&) = delete;
+    HitchDetector& operator=(const HitchDetector&) = delete;
+
+    struct Event {
+        HitchEvent kind = HitchEvent::Texture;
+        std::string detail;
+        double milliseconds = 0.0;
+        size_t bytes = 0;
+    };
+
+    struct Culprit {
+        int hitches = 0;
+        double totalMs = 0.0;
+        double worstFrameMs = 0.0;
+        size_t bytes = 0;
+    };
+
+    struct Hitch {
+        uint64_t frame = 0;
+        double milliseconds = 0.0;
+        std::vector<Event> events;
+    };
+
+    bool IsMainThread() const;
+    void OnHitch(double frameMs);
+
+    std::thread::id mainThread_;
+    bool installed_ = false;
+    double budgetMs_ = DEFAULT_BUDGET_MS;
+
+    Clock::time_point lastFrame_;
+    bool started_ = false;
+    bool ignoreFrame_ = false;
+    uint64_t frames_ = 0;
+    std::array<float, HISTORY_FRAMES> history_ = {};
+    std::vector<Event> events_;
+
+    int hitches_ = 0;
+    std::map<std::pair<HitchEvent, std::string>, Culprit> culprits_;
+    std::vector<Hitch> worst_;
+};
@@ -0,0 +1,37 @@
+#include "IdlePacer.hpp"
+#include "HitchDetector.hpp"
+#include <algorithm>
+#include <cmath>
+
+IdlePacer& IdlePacer::GetInstance() {
+    static IdlePacer instance;
+    return instance;
+}
+
+int IdlePacer::Tick(bool idle) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 previous = lastTick_;
+    lastTick_ = now;
+
+    if (!enabled_ || !idle) {
+        idleTicks_ = 0;
+        return 1;
+    }
+    if (idleTicks_ < IDLE_TICKS) {
+        idleTicks_++;
+        return 1;
+    }
+
+    // The wait returns early as soon as an event is queued, without taking it.
+    double elapsedMs = previous ? static_cast<double>(now - previous) * 1000.0 / SDL_GetPerformanceFrequency() : 0.0;
+    if (elapsedMs < IDLE_TICK_MS) {
+        SDL_WaitEventTimeout(nullptr, static_cast<int>(IDLE_TICK_MS - elapsedMs));
+        now = SDL_GetPerformanceCounter();
+        lastTick_ = now;
+    }
+    HitchDetector::GetInstance().IgnoreFrame();
+
+    if (!previous) return 1;
+    double totalMs = static_cast<double>(now - previous) * 1000.0 / SDL_GetPerformanceFrequency();
+    return std::clamp(static_cast<int>(std::lround(totalMs / TICK_MS)), 1, MAX_TICKS);
+}
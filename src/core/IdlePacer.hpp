@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Lowers the tick rate while the current state reports that nothing on
+// screen is changing. After a short idle streak each tick waits up to
+// IDLE_TICK_MS for input instead of running at full rate, and returns how
+// many 60 Hz ticks actually passed so timed screens keep their real-time
+// length. Input wakes it immediately.
+class IdlePacer {
+public:
+    static IdlePacer& GetInstance();
+
+    // Call once at the start of each Update on the main thread.
+    int Tick(bool idle);
+
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+    bool IsEnabled() const { return enabled_; }
+    bool IsThrottling() const { return enabled_ && idleTicks_ >= IDLE_TICKS; }
+
+    static constexpr int IDLE_TICKS = 15;
+    static constexpr Uint32 IDLE_TICK_MS = 100;
+    static constexpr double TICK_MS = 1000.0 / 60.0;
+    static constexpr int MAX_TICKS = 10;
+
+private:
+    IdlePacer() = default;
+    IdlePacer(const IdlePacer&) = delete;
+    IdlePacer& operator=(const IdlePacer&) = delete;
+
+    bool enabled_ = true;
+    int idleTicks_ = 0;
+    Uint64 lastTick_ = 0;
+};
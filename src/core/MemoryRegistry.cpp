@@ -0,0 +1,206 @@
+#include "MemoryRegistry.hpp"
+#include "HitchDetector.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+MemoryRegistry& MemoryRegistry::GetInstance() {
+    static MemoryRegistry instance;
+    return instance;
+}
+
+void MemoryRegistry::Track(const void* key, ResourceKind kind, const std::string& owner, const std::string& path, size_t bytes) {
+    if (!key) return;
+    HitchDetector::GetInstance().RecordAllocation(path, bytes);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Tracking a key again, e.g. a cached texture handed out twice, keeps
+    // the states already referencing it.
+    std::vector<std::string> users;
+    auto existing = entries_.find(key);
+    if (existing != entries_.end()) {
+        users = existing->second.users;
+        Remove(existing);
+    }
+    users.erase(std::remove(users.begin(), users.end(), owner), users.end());
+    entries_[key] = {kind, owner, path, bytes, users};
+
+    Charge(owner, bytes, path);
+    for (const auto& user : users) {
+        Charge(user, bytes, path);
+    }
+}
+
+void MemoryRegistry::TrackTexture(SDL_Texture* texture, ResourceKind kind, const std::string& owner, const std::string& path) {
+    Track(texture, kind, owner, path, GetTextureBytes(texture));
+}
+
+void MemoryRegistry::TrackSharedTexture(SDL_Texture* texture, ResourceKind kind, const std::string& user, const std::string& path) {
+    TrackTexture(texture, kind, RESOURCE_MANAGER_OWNER, path);
+    AddReference(texture, user);
+}
+
+void MemoryRegistry::AddReference(const void* key, const std::string& user) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(key);
+    if (entry == entries_.end() || entry->second.owner == user) return;
+
+    auto& users = entry->second.users;
+    if (std::find(users.begin(), users.end(), user) != users.end()) return;
+    users.push_back(user);
+    Charge(user, entry->second.bytes, entry->second.path);
+}
+
+void MemoryRegistry::Charge(const std::string& owner, size_t bytes, const std::string& path) {
+    OwnerStats& stats = owners_[owner];
+    stats.bytes += bytes;
+    stats.highWater = std::max(stats.highWater, stats.bytes);
+    if (stats.budget > 0 && stats.bytes > stats.budget && !stats.overBudget) {
+        stats.overBudget = true;
+        std::cerr << owner << " is over its memory budget: " << stats.bytes << " / " << stats.budget
+                  << " bytes (last: " << path << ")" << std::endl;
+    }
+}
+
+void MemoryRegistry::Discharge(const std::string& owner, size_t bytes) {
+    OwnerStats& stats = owners_[owner];
+    stats.bytes -= std::min(stats.bytes, bytes);
+    if (stats.bytes <= stats.budget) {
+        stats.overBudget = false;
+    }
+}
+
+void MemoryRegistry::Untrack(const void* key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(key);
+    if (entry != entries_.end()) {
+        Remove(entry);
+    }
+}
+
+void MemoryRegistry::UntrackOwner(const std::string& owner) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto entry = entries_.begin(); entry != entries_.end();) {
+        if (entry->second.owner == owner) {
+            auto next = std::next(entry);
+            Remove(entry);
+            entry = next;
+            continue;
+        }
+
+        auto& users = entry->second.users;
+        auto user = std::find(users.begin(), users.end(), owner);
+        if (user != users.end()) {
+            users.erase(user);
+            Discharge(owner, entry->second.bytes);
+        }
+        ++entry;
+    }
+}
+
+void MemoryRegistry::Remove(std::unordered_map<const void*, Entry>::iterator entry) {
+    Discharge(entry->second.owner, entry->second.bytes);
+    for (const auto& user : entry->second.users) {
+        Discharge(user, entry->second.bytes);
+    }
+    entries_.erase(entry);
+}
+
+size_t MemoryRegistry::GetBytes(const std::string& owner) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto stats = owners_.find(owner);
+    return stats == owners_.end() ? 0 : stats->second.bytes;
+}
+
+size_t MemoryRegistry::GetBytes(ResourceKind kind) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& entry : entries_) {
+        if (entry.second.kind == kind) total += entry.second.bytes;
+    }
+    return total;
+}
+
+size_t MemoryRegistry::GetTotalBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& entry : entries_) {
+        total += entry.second.bytes;
+    }
+    return total;
+}
+
+size_t MemoryRegistry::GetHighWater(const std::string& owner) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto stats = owners_.find(owner);
+    return stats == owners_.end() ? 0 : stats->second.highWater;
+}
+
+std::vector<MemoryRegistry::Entry> MemoryRegistry::GetEntries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Entry> entries;
+    entries.reserve(entries_.size());
+    for (const auto& entry : entries_) {
+        entries.push_back(entry.second);
+    }
+    return entries;
+}
+
+void MemoryRegistry::SetBudget(const std::string& owner, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    OwnerStats& stats = owners_[owner];
+    stats.budget = bytes;
+    stats.overBudget = bytes > 0 && stats.bytes > bytes;
+}
+
+bool MemoryRegistry::DumpJson(const std::string& path) const {
+    nlohmann::json root;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& owner : owners_) {
+            root["owners"][owner.first] = {
+                {"bytes", owner.second.bytes},
+                {"highWater", owner.second.highWater},
+                {"budget", owner.second.budget}
+            };
+        }
+
+        nlohmann::json resources = nlohmann::json::array();
+        for (const auto& entry : entries_) {
+            resources.push_back({
+                {"kind", GetKindName(entry.second.kind)},
+                {"owner", entry.second.owner},
+                {"path", entry.second.path},
+                {"bytes", entry.second.bytes},
+                {"users", entry.second.users}
+            });
+        }
+        root["resources"] = std::move(resources);
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write memory dump: " << path << std::endl;
+        return false;
+    }
+    file << root.dump(2) << std::endl;
+    return true;
+}
+
+size_t MemoryRegistry::GetTextureBytes(SDL_Texture* texture) {
+    Uint32 format = 0;
+    int w = 0, h = 0;
+    if (!texture || SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) return 0;
+    return static_cast<size_t>(w) * h * SDL_BYTESPERPIXEL(format);
+}
+
+const char* MemoryRegistry::GetKindName(ResourceKind kind) {
+    switch (kind) {
+        case ResourceKind::Texture: return "texture";
+        case ResourceKind::Font: return "font";
+        case ResourceKind::Audio: return "audio";
+        default: return "other";
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class ResourceKind {
+    Texture,
+    Font,
+    Audio,
+    Other
+};
+
+// Central accounting of resident resource memory. Loaders report each
+// allocation with the owning state and asset path; the registry keeps
+// per-owner totals, high-water marks and optional budgets, and can dump
+// everything to JSON. A resource several states share is tracked once under
+// the holder and referenced by each state using it; references count toward
+// that state's totals and budget but not toward the overall total. Safe to
+// use from loader threads.
+class MemoryRegistry {
+public:
+    struct Entry {
+        ResourceKind kind = ResourceKind::Other;
+        std::string owner;
+        std::string path;
+        size_t bytes = 0;
+        std::vector<std::string> users;
+    };
+
+    static MemoryRegistry& GetInstance();
+
+    void Track(const void* key, ResourceKind kind, const std::string& owner, const std::string& path, size_t bytes);
+    void TrackTexture(SDL_Texture* texture, ResourceKind kind, const std::string& owner, const std::string& path);
+    // Tracks a ResourceManager texture under RESOURCE_MANAGER_OWNER and
+    // references it from user.
+    void TrackSharedTexture(SDL_Texture* texture, ResourceKind kind, const std::string& user, const std::string& path);
+    void AddReference(const void* key, const std::string& user);
+    void Untrack(const void* key);
+    void UntrackOwner(const std::string& owner);
+
+    size_t GetBytes(const std::string& owner) const;
+    size_t GetBytes(ResourceKind kind) const;
+    size_t GetTotalBytes() const;
+    size_t GetHighWater(const std::string& owner) const;
+    std::vector<Entry> GetEntries() const;
+
+    void SetBudget(const std::string& owner, size_t bytes);
+    bool DumpJson(const std::string& path) const;
+
+    static size_t GetTextureBytes(SDL_Texture* texture);
+    static const char* GetKindName(ResourceKind kind);
+
+    static constexpr const char* DUMP_PATH = "memory.json";
+    // Textures handed out by ResourceManager stay resident after the state
+    // that asked for them exits, so they are accounted to the manager.
+    static constexpr const char* RESOURCE_MANAGER_OWNER = "ResourceManager";
+
+private:
+    MemoryRegistry() = default;
+    MemoryRegistry(const MemoryRegistry&) = delete;
+    MemoryRegistry& operator=(const MemoryRegistry&) = delete;
+
+    struct OwnerStats {
+        size_t bytes = 0;
+        size_t highWater = 0;
+        size_t budget = 0;
+        bool overBudget = false;
+    };
+
+    void Charge(const std::string& owner, size_t bytes, const std::string& path);
+    void Discharge(const std::string& owner, size_t bytes);
+    void Remove(std::unordered_map<const void*, Entry>::iterator entry);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<const void*, Entry> entries_;
+    std::unordered_map<std::string, OwnerStats> owners_;
+};
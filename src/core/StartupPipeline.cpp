@@ -0,0 +1,53 @@
+#include "StartupPipeline.hpp"
+#include "StartupTrace.hpp"
+#include <fstream>
+#include <iostream>
+
+StartupPipeline::~StartupPipeline() {
+    Wait();
+}
+
+void StartupPipeline::AddBackground(const std::string& name, std::function<void()> task) {
+    background_.push_back({name, std::move(task)});
+}
+
+void StartupPipeline::AddMain(const std::string& name, std::function<bool()> task) {
+    main_.push_back({name, std::move(task)});
+}
+
+bool StartupPipeline::Run() {
+    StartupTrace::GetInstance().AddPending(static_cast<int>(background_.size()));
+    for (const auto& task : background_) {
+        threads_.emplace_back([&task]() {
+            {
+                StartupTrace::Scope scope(task.name.c_str());
+                task.task();
+            }
+            StartupTrace::GetInstance().FinishPending();
+        });
+    }
+
+    for (const auto& task : main_) {
+        StartupTrace::Scope scope(task.name.c_str());
+        if (!task.task()) {
+            std::cerr << "Startup step failed: " << task.name << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void StartupPipeline::Wait() {
+    for (auto& thread : threads_) {
+        if (thread.joinable()) thread.join();
+    }
+    threads_.clear();
+}
+
+void StartupPipeline::PrefetchFiles(const std::vector<std::string>& paths) {
+    char buffer[64 * 1024];
+    for (const auto& path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {}
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Startup work split into main-thread steps, which run in order, and
+// background tasks that start first and overlap them. Every task is timed
+// into the StartupTrace.
+class StartupPipeline {
+public:
+    StartupPipeline() = default;
+    ~StartupPipeline();
+
+    StartupPipeline(const StartupPipeline&) = delete;
+    StartupPipeline& operator=(const StartupPipeline&) = delete;
+
+    void AddBackground(const std::string& name, std::function<void()> task);
+    void AddMain(const std::string& name, std::function<bool()> task);
+
+    bool Run();
+    void Wait();
+
+    // Reads files through once so the loads that follow hit the OS cache.
+    static void PrefetchFiles(const std::vector<std::string>& paths);
+
+private:
+    struct BackgroundTask {
+        std::string name;
+        std::function<void()> task;
+    };
+
+    struct MainTask {
+        std::string name;
+        std::function<bool()> task;
+    };
+
+    std::vector<BackgroundTask> background_;
+    std::vector<MainTask> main_;
+    std::vector<std::thread> threads_;
+};
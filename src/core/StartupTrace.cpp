@@ -0,0 +1,90 @@
+#include "StartupTrace.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    double Milliseconds(StartupTrace::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+StartupTrace::Scope::Scope(const char* phase)
+    : phase_(phase)
+    , start_(Clock::now())
+{}
+
+StartupTrace::Scope::~Scope() {
+    StartupTrace::GetInstance().Record(phase_, start_, Clock::now());
+}
+
+StartupTrace& StartupTrace::GetInstance() {
+    static StartupTrace instance;
+    return instance;
+}
+
+StartupTrace::StartupTrace()
+    : origin_(Clock::now())
+{}
+
+void StartupTrace::Record(const char* phase, Clock::time_point start, Clock::time_point end) {
+    if (!enabled_) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases_.push_back({phase, start, end, std::this_thread::get_id()});
+}
+
+void StartupTrace::AddPending(int count) {
+    pending_ += count;
+}
+
+void StartupTrace::FinishPending() {
+    if (--pending_ == 0) ReportWhenDone();
+}
+
+void StartupTrace::MarkFirstFrame() {
+    if (firstFrameSeen_) return;
+
+    if (enabled_) {
+        Clock::time_point now = Clock::now();
+        Record("First frame", now, now);
+    }
+    firstFrameSeen_ = true;
+    ReportWhenDone();
+}
+
+// Background tasks can outlast the first frame; the report waits for them so
+// it shows the overlap, and is printed from whichever thread finishes last.
+void StartupTrace::ReportWhenDone() {
+    if (!enabled_ || !firstFrameSeen_ || pending_ > 0) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (reported_) return;
+        reported_ = true;
+    }
+    Report();
+}
+
+void StartupTrace::Report() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::sort(phases_.begin(), phases_.end(), [](const Phase& a, const Phase& b) { return a.start < b.start; });
+
+    std::vector<std::thread::id> threads;
+    std::streamsize precision = std::cerr.precision();
+    std::cerr << "Startup trace (ms since launch):" << std::endl;
+    for (const auto& phase : phases_) {
+        auto thread = std::find(threads.begin(), threads.end(), phase.thread);
+        if (thread == threads.end()) {
+            threads.push_back(phase.thread);
+            thread = threads.end() - 1;
+        }
+
+        std::cerr << std::fixed << std::setprecision(1)
+                  << "  " << std::setw(8) << Milliseconds(phase.start - origin_)
+                  << " " << std::setw(8) << Milliseconds(phase.end - origin_)
+                  << " " << std::setw(8) << Milliseconds(phase.end - phase.start)
+                  << "  [" << (thread - threads.begin()) << "] " << phase.name << std::endl;
+    }
+    std::cerr.unsetf(std::ios::floatfield);
+    std::cerr.precision(precision);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Collects timed startup phases from any thread and prints them, relative to
+// process start, once the first frame has been drawn and every pending
+// background task has finished, whichever comes last. Off unless enabled.
+class StartupTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class Scope {
+    public:
+        explicit Scope(const char* phase);
+        ~Scope();
+
+    private:
+        const char* phase_;
+        Clock::time_point start_;
+    };
+
+    static StartupTrace& GetInstance();
+
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+    bool IsEnabled() const { return enabled_; }
+
+    void Record(const char* phase, Clock::time_point start, Clock::time_point end);
+    void AddPending(int count);
+    void FinishPending();
+    void MarkFirstFrame();
+    void Report();
+
+private:
+    StartupTrace();
+
+    struct Phase {
+        std::string name;
+        Clock::time_point start;
+        Clock::time_point end;
+        std::thread::id thread;
+    };
+
+    void ReportWhenDone();
+
+    Clock::time_point origin_;
+    std::mutex mutex_;
+    std::vector<Phase> phases_;
+    bool enabled_ = false;
+    bool reported_ = false;
+    std::atomic<bool> firstFrameSeen_{false};
+    std::atomic<int> pending_{0};
+};
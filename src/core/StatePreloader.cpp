@@ -0,0 +1,74 @@
+#include "StatePreloader.hpp"
+#include <iostream>
+
+StatePreloader::~StatePreloader() {
+    Join();
+}
+
+void StatePreloader::Start(std::unique_ptr<GameState> state) {
+    Cancel();
+    if (!state) return;
+
+    state_ = std::move(state);
+    GameState* target = state_.get();
+    thread_ = std::thread([this, target]() {
+        prepareResult_ = target->Prepare();
+        prepared_.store(true, std::memory_order_release);
+    });
+}
+
+bool StatePreloader::Poll() {
+    if (ready_) return true;
+    if (!state_ || failed_) return false;
+    if (!prepared_.load(std::memory_order_acquire)) return false;
+
+    Join();
+    if (!prepareResult_) {
+        std::cerr << "Failed to preload next state" << std::endl;
+        failed_ = true;
+        state_.reset();
+        return false;
+    }
+
+    ready_ = true;
+    return true;
+}
+
+void StatePreloader::Cancel() {
+    Join();
+    state_.reset();
+    prepared_ = false;
+    prepareResult_ = false;
+    ready_ = false;
+    failed_ = false;
+}
+
+std::unique_ptr<GameState> StatePreloader::Take() {
+    if (!ready_) return nullptr;
+    ready_ = false;
+    prepared_ = false;
+    return std::move(state_);
+}
+
+void StatePreloader::Hand(std::unique_ptr<GameState> state) {
+    Handed() = std::move(state);
+}
+
+std::unique_ptr<GameState> StatePreloader::TakeHanded() {
+    return std::move(Handed());
+}
+
+void StatePreloader::ReleaseHanded() {
+    Handed().reset();
+}
+
+std::unique_ptr<GameState>& StatePreloader::Handed() {
+    static std::unique_ptr<GameState> handed;
+    return handed;
+}
+
+void StatePreloader::Join() {
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
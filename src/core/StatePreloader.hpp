@@ -0,0 +1,44 @@
+#pragma once
+
+#include "states/GameState.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+// Runs a state's Prepare on a loader thread while the current state keeps
+// updating. Poll returns true once that is done, so the caller can switch
+// states on a frame boundary. GameContext builds the next state itself, so
+// the prepared one is passed on with Hand and the new instance picks it up
+// with TakeHanded in its Initialize. A state nobody took is freed by
+// ReleaseHanded, which must run while SDL is still up.
+class StatePreloader {
+public:
+    StatePreloader() = default;
+    ~StatePreloader();
+
+    StatePreloader(const StatePreloader&) = delete;
+    StatePreloader& operator=(const StatePreloader&) = delete;
+
+    void Start(std::unique_ptr<GameState> state);
+    bool Poll();
+    void Cancel();
+
+    bool IsLoading() const { return state_ != nullptr && !ready_; }
+    bool HasFailed() const { return failed_; }
+    std::unique_ptr<GameState> Take();
+
+    static void Hand(std::unique_ptr<GameState> state);
+    static std::unique_ptr<GameState> TakeHanded();
+    static void ReleaseHanded();
+
+private:
+    void Join();
+    static std::unique_ptr<GameState>& Handed();
+
+    std::unique_ptr<GameState> state_;
+    std::thread thread_;
+    std::atomic<bool> prepared_{false};
+    bool prepareResult_ = false;
+    bool ready_ = false;
+    bool failed_ = false;
+};
@@ -0,0 +1,97 @@
+#include "AnimationGroup.hpp"
+#include "core/HitchDetector.hpp"
+#include <resources/ResourceManager.hpp>
+#include <tinyxml2.h>
+#include <iostream>
+
+namespace {
+    int IntAttribute(const tinyxml2::XMLElement* element, const char* name, const char* alias, int defaultValue) {
+        int value = defaultValue;
+        if (element->QueryIntAttribute(name, &value) != tinyxml2::XML_SUCCESS && alias) {
+            element->QueryIntAttribute(alias, &value);
+        }
+        return value;
+    }
+}
+
+AnimationGroup::AnimationGroup() {}
+
+bool AnimationGroup::Load(const std::string& path) {
+    std::string filePath = "data/SONICORCA/" + path + ".anigroup";
+    tinyxml2::XMLDocument doc;
+    if (doc.LoadFile(filePath.c_str()) != tinyxml2::XML_SUCCESS) {
+        std::cerr << "Failed to load animation group: " << filePath << std::endl;
+        return false;
+    }
+
+    const tinyxml2::XMLElement* root = doc.FirstChildElement("animationgroup");
+    if (!root) {
+        std::cerr << "Invalid animation group: " << filePath << std::endl;
+        return false;
+    }
+
+    textures_.clear();
+    texturePaths_.clear();
+    if (const tinyxml2::XMLElement* texturesElement = root->FirstChildElement("textures")) {
+        for (const tinyxml2::XMLElement* texture = texturesElement->FirstChildElement("texture");
+             texture; texture = texture->NextSiblingElement("texture")) {
+            const char* texturePath = texture->Attribute("path");
+            if (!texturePath) texturePath = texture->GetText();
+
+            std::string resourcePath = texturePath ? texturePath : "";
+            if (resourcePath.find('.') == std::string::npos) {
+                resourcePath += ".png";
+            }
+
+            HitchDetector::Scope hitch(HitchEvent::Texture, resourcePath);
+            SDL_Texture* loaded = ResourceManager::GetInstance().LoadTexture(resourcePath);
+            if (!loaded) {
+                std::cerr << "Failed to load animation texture: " << resourcePath << std::endl;
+            }
+            textures_.push_back(loaded);
+            texturePaths_.push_back(resourcePath);
+        }
+    }
+
+    animations_.clear();
+    frameTextures_.clear();
+    frameSources_.clear();
+    frameOrigins_.clear();
+    frameDurations_.clear();
+    nextFrames_.clear();
+
+    for (const tinyxml2::XMLElement* animation = root->FirstChildElement("animation");
+         animation; animation = animation->NextSiblingElement("animation")) {
+        uint32_t first = static_cast<uint32_t>(frameTextures_.size());
+
+        for (const tinyxml2::XMLElement* frame = animation->FirstChildElement("frame");
+             frame; frame = frame->NextSiblingElement("frame")) {
+            int texture = frame->IntAttribute("texture", 0);
+            frameTextures_.push_back(texture >= 0 && texture < static_cast<int>(textures_.size()) ? textures_[texture] : nullptr);
+            frameSources_.push_back({
+                frame->IntAttribute("x", 0),
+                frame->IntAttribute("y", 0),
+                IntAttribute(frame, "w", "width", 0),
+                IntAttribute(frame, "h", "height", 0)
+            });
+            frameOrigins_.push_back({
+                IntAttribute(frame, "ox", "offsetx", 0),
+                IntAttribute(frame, "oy", "offsety", 0)
+            });
+            frameDurations_.push_back(static_cast<uint16_t>(IntAttribute(frame, "delay", "duration", 1)));
+            nextFrames_.push_back(static_cast<uint32_t>(frameTextures_.size()));
+        }
+
+        uint32_t count = static_cast<uint32_t>(frameTextures_.size()) - first;
+        animations_.push_back({first, count});
+        if (count == 0) continue;
+
+        int loopFrame = IntAttribute(animation, "loopframe", "loop", 0);
+        if (loopFrame < 0 || loopFrame >= static_cast<int>(count)) {
+            loopFrame = 0;
+        }
+        nextFrames_.back() = first + static_cast<uint32_t>(loopFrame);
+    }
+
+    return true;
+}
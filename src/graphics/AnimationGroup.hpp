@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// An S2HD animation group parsed once into flat per-frame tables. Each frame
+// also stores the index of the frame that follows it, loops included, so
+// advancing an animation is a single table read.
+class AnimationGroup {
+public:
+    struct Animation {
+        uint32_t firstFrame;
+        uint32_t frameCount;
+    };
+
+    AnimationGroup();
+
+    bool Load(const std::string& path);
+
+    size_t GetAnimationCount() const { return animations_.size(); }
+    const Animation& GetAnimation(int index) const { return animations_[index]; }
+
+    size_t GetTextureCount() const { return textures_.size(); }
+    SDL_Texture* GetTexture(size_t index) const { return textures_[index]; }
+    const std::string& GetTexturePath(size_t index) const { return texturePaths_[index]; }
+
+    SDL_Texture* GetFrameTexture(uint32_t frame) const { return frameTextures_[frame]; }
+    const SDL_Rect& GetFrameSource(uint32_t frame) const { return frameSources_[frame]; }
+    const SDL_Point& GetFrameOrigin(uint32_t frame) const { return frameOrigins_[frame]; }
+    uint16_t GetFrameDuration(uint32_t frame) const { return frameDurations_[frame]; }
+    uint32_t GetNextFrame(uint32_t frame) const { return nextFrames_[frame]; }
+
+private:
+    std::vector<Animation> animations_;
+    std::vector<SDL_Texture*> textures_;
+    std::vector<std::string> texturePaths_;
+    std::vector<SDL_Texture*> frameTextures_;
+    std::vector<SDL_Rect> frameSources_;
+    std::vector<SDL_Point> frameOrigins_;
+    std::vector<uint16_t> frameDurations_;
+    std::vector<uint32_t> nextFrames_;
+};
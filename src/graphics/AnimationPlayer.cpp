@@ -0,0 +1,78 @@
+#include "AnimationPlayer.hpp"
+
+AnimationPlayer::AnimationPlayer(const AnimationGroup* group)
+    : group_(group)
+{
+}
+
+int AnimationPlayer::Add(int animation, float x, float y) {
+    frames_.push_back(0);
+    ticks_.push_back(0);
+    x_.push_back(x);
+    y_.push_back(y);
+    visible_.push_back(1);
+
+    int instance = static_cast<int>(frames_.size()) - 1;
+    Play(instance, animation);
+    return instance;
+}
+
+void AnimationPlayer::Play(int instance, int animation) {
+    if (animation < 0 || animation >= static_cast<int>(group_->GetAnimationCount()) ||
+        group_->GetAnimation(animation).frameCount == 0) {
+        visible_[instance] = 0;
+        return;
+    }
+
+    uint32_t frame = group_->GetAnimation(animation).firstFrame;
+    frames_[instance] = frame;
+    ticks_[instance] = group_->GetFrameDuration(frame);
+    visible_[instance] = 1;
+}
+
+void AnimationPlayer::SetPosition(int instance, float x, float y) {
+    x_[instance] = x;
+    y_[instance] = y;
+}
+
+void AnimationPlayer::SetVisible(int instance, bool visible) {
+    visible_[instance] = visible ? 1 : 0;
+}
+
+void AnimationPlayer::Clear() {
+    frames_.clear();
+    ticks_.clear();
+    x_.clear();
+    y_.clear();
+    visible_.clear();
+}
+
+void AnimationPlayer::Update() {
+    // A duration of zero holds the frame forever.
+    size_t count = frames_.size();
+    for (size_t i = 0; i < count; i++) {
+        if (ticks_[i] == 0) continue;
+        if (--ticks_[i] == 0) {
+            frames_[i] = group_->GetNextFrame(frames_[i]);
+            ticks_[i] = group_->GetFrameDuration(frames_[i]);
+        }
+    }
+}
+
+void AnimationPlayer::Draw(SpriteBatch& batch) const {
+    size_t count = frames_.size();
+    for (size_t i = 0; i < count; i++) {
+        if (!visible_[i]) continue;
+
+        uint32_t frame = frames_[i];
+        const SDL_Rect& source = group_->GetFrameSource(frame);
+        const SDL_Point& origin = group_->GetFrameOrigin(frame);
+        SDL_FRect dest = {
+            x_[i] - origin.x,
+            y_[i] - origin.y,
+            static_cast<float>(source.w),
+            static_cast<float>(source.h)
+        };
+        batch.Draw(group_->GetFrameTexture(frame), source, dest);
+    }
+}
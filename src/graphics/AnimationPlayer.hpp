@@ -0,0 +1,30 @@
+#pragma once
+
+#include "AnimationGroup.hpp"
+#include "SpriteBatch.hpp"
+#include <cstdint>
+#include <vector>
+
+// Plays many instances of animations from one group. Instance state is kept
+// in parallel arrays and advanced for all instances in one pass.
+class AnimationPlayer {
+public:
+    explicit AnimationPlayer(const AnimationGroup* group);
+
+    int Add(int animation, float x, float y);
+    void Play(int instance, int animation);
+    void SetPosition(int instance, float x, float y);
+    void SetVisible(int instance, bool visible);
+    void Clear();
+
+    void Update();
+    void Draw(SpriteBatch& batch) const;
+
+private:
+    const AnimationGroup* group_;
+    std::vector<uint32_t> frames_;
+    std::vector<uint16_t> ticks_;
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<uint8_t> visible_;
+};
@@ -0,0 +1,124 @@
+#include "FlashVariants.hpp"
+#include "OverdrawMap.hpp"
+#include "PremultipliedAlpha.hpp"
+#include "core/MemoryRegistry.hpp"
+#include <algorithm>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WHITEN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+FlashVariants& FlashVariants::GetInstance() {
+    static FlashVariants instance;
+    return instance;
+}
+
+SDL_Texture* FlashVariants::Get(SDL_Renderer* renderer, SDL_Texture* source, const std::string& owner) {
+    if (!source) return nullptr;
+
+    auto existing = variants_.find(source);
+    if (existing != variants_.end()) return existing->second;
+
+    SDL_Texture* variant = Create(renderer, source);
+    if (variant) {
+        variants_[source] = variant;
+        MemoryRegistry::GetInstance().TrackTexture(variant, ResourceKind::Texture, owner, "flash variant");
+    }
+    return variant;
+}
+
+void FlashVariants::Release(SDL_Texture* source) {
+    auto existing = variants_.find(source);
+    if (existing == variants_.end()) return;
+
+    MemoryRegistry::GetInstance().Untrack(existing->second);
+    SDL_DestroyTexture(existing->second);
+    variants_.erase(existing);
+}
+
+void FlashVariants::Shutdown() {
+    for (auto& variant : variants_) {
+        MemoryRegistry::GetInstance().Untrack(variant.second);
+        SDL_DestroyTexture(variant.second);
+    }
+    variants_.clear();
+}
+
+SDL_Texture* FlashVariants::Create(SDL_Renderer* renderer, SDL_Texture* source) {
+    int width = 0, height = 0;
+    if (SDL_QueryTexture(source, nullptr, nullptr, &width, &height) != 0 || width <= 0 || height <= 0) return nullptr;
+
+    // Static textures can't be read directly, so copy the source unblended
+    // into a target and read that back.
+    SDL_Texture* target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!target) return nullptr;
+
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    Uint8 r = 255, g = 255, b = 255, a = 255;
+    SDL_GetTextureBlendMode(source, &blendMode);
+    SDL_GetTextureColorMod(source, &r, &g, &b);
+    SDL_GetTextureAlphaMod(source, &a);
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+
+    std::vector<Uint32> pixels(static_cast<size_t>(width) * height);
+    SDL_SetRenderTarget(renderer, target);
+    SDL_SetTextureBlendMode(source, SDL_BLENDMODE_NONE);
+    SDL_SetTextureColorMod(source, 255, 255, 255);
+    SDL_SetTextureAlphaMod(source, 255);
+    SDL_RenderCopy(renderer, source, nullptr, nullptr);
+    int read = SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(), width * static_cast<int>(sizeof(Uint32)));
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_SetTextureBlendMode(source, blendMode);
+    SDL_SetTextureColorMod(source, r, g, b);
+    SDL_SetTextureAlphaMod(source, a);
+    SDL_DestroyTexture(target);
+    if (read != 0) return nullptr;
+
+    Whiten(pixels.data(), pixels.size(), blendMode == PremultipliedAlpha::GetBlendMode());
+
+    SDL_Texture* variant = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height);
+    if (!variant) return nullptr;
+    SDL_UpdateTexture(variant, nullptr, pixels.data(), width * static_cast<int>(sizeof(Uint32)));
+    SDL_SetTextureBlendMode(variant, blendMode);
+    return variant;
+}
+
+void FlashVariants::Draw(SDL_Renderer* renderer, SDL_Texture* source, SDL_Texture* variant, const SDL_Rect* dest,
+                         float amount, SDL_RendererFlip flip) {
+    if (!variant || amount <= 0.0f) {
+        OverdrawMap::CopyEx(renderer, source, nullptr, dest, 0.0, nullptr, flip);
+        return;
+    }
+
+    if (amount < 1.0f) {
+        OverdrawMap::CopyEx(renderer, source, nullptr, dest, 0.0, nullptr, flip);
+    }
+    PremultipliedAlpha::SetOpacity(variant, static_cast<Uint8>(std::min(amount, 1.0f) * 255));
+    OverdrawMap::CopyEx(renderer, variant, nullptr, dest, 0.0, nullptr, flip);
+}
+
+void FlashVariants::Whiten(Uint32* pixels, size_t count, bool premultiplied) {
+    size_t i = 0;
+#ifdef WHITEN_SSE2
+    const __m128i white = _mm_set1_epi32(0x00FFFFFF);
+    for (; i + 4 <= count; i += 4) {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + i);
+        __m128i source = _mm_loadu_si128(block);
+        if (premultiplied) {
+            __m128i alpha = _mm_srli_epi32(source, 24);
+            alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 8));
+            source = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+        } else {
+            source = _mm_or_si128(source, white);
+        }
+        _mm_storeu_si128(block, source);
+    }
+#endif
+    for (; i < count; i++) {
+        Uint32 alpha = pixels[i] >> 24;
+        pixels[i] = premultiplied ? alpha * 0x01010101u : pixels[i] | 0x00FFFFFFu;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+// Load-time white-silhouette copies of textures for the title's white
+// flashes. Drawing the silhouette over the original with alpha gives the
+// fade-to-white look with one extra copy of the sprite itself, where colour
+// mods can only darken and a full-screen white rect costs a whole pass.
+class FlashVariants {
+public:
+    static FlashVariants& GetInstance();
+
+    // The source is read back through a render target once; later calls
+    // return the cached variant.
+    SDL_Texture* Get(SDL_Renderer* renderer, SDL_Texture* source, const std::string& owner);
+    void Release(SDL_Texture* source);
+    // Frees every variant; call before the renderer is destroyed.
+    void Shutdown();
+
+    // Draws the source, then its silhouette at `amount`; at full strength
+    // only the silhouette.
+    static void Draw(SDL_Renderer* renderer, SDL_Texture* source, SDL_Texture* variant, const SDL_Rect* dest,
+                     float amount, SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+    // Straight alpha keeps alpha and sets colour to white; premultiplied
+    // sets every channel to alpha.
+    static void Whiten(Uint32* pixels, size_t count, bool premultiplied);
+
+private:
+    FlashVariants() = default;
+    ~FlashVariants() = default;
+    FlashVariants(const FlashVariants&) = delete;
+    FlashVariants& operator=(const FlashVariants&) = delete;
+
+    static SDL_Texture* Create(SDL_Renderer* renderer, SDL_Texture* source);
+
+    std::unordered_map<SDL_Texture*, SDL_Texture*> variants_;
+};
@@ -0,0 +1,170 @@
+#include "OverdrawMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    // Black for untouched pixels, then blue through red to white at MAX_LEVEL.
+    const Uint32 HEAT_COLORS[OverdrawMap::MAX_LEVEL + 1] = {
+        0xFF000000, 0xFF0000A0, 0xFF0080FF, 0xFF00C000, 0xFFFFFF00,
+        0xFFFF8000, 0xFFFF0000, 0xFFC00060, 0xFFFFFFFF
+    };
+}
+
+OverdrawMap& OverdrawMap::GetInstance() {
+    static OverdrawMap instance;
+    return instance;
+}
+
+void OverdrawMap::Toggle() {
+    enabled_ = !enabled_;
+    if (!enabled_) Release();
+}
+
+void OverdrawMap::Shutdown() {
+    enabled_ = false;
+    capturing_ = false;
+    Release();
+}
+
+void OverdrawMap::Release() {
+    if (window_) {
+        SDL_SetWindowTitle(window_, windowTitle_.c_str());
+        window_ = nullptr;
+    }
+    if (heatmap_) SDL_DestroyTexture(heatmap_);
+    heatmap_ = nullptr;
+    width_ = 0;
+    height_ = 0;
+    rects_.clear();
+    counts_.clear();
+    pixels_.clear();
+}
+
+void OverdrawMap::BeginFrame(SDL_Renderer* renderer) {
+    capturing_ = enabled_;
+    if (!capturing_) return;
+
+    // Draw calls are in render coordinates, so count in the logical size.
+    int width = 0, height = 0;
+    SDL_RenderGetLogicalSize(renderer, &width, &height);
+    if (width == 0 || height == 0) {
+        float scaleX = 1.0f, scaleY = 1.0f;
+        SDL_GetRendererOutputSize(renderer, &width, &height);
+        SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+        width = static_cast<int>(width / scaleX);
+        height = static_cast<int>(height / scaleY);
+    }
+
+    if (width != width_ || height != height_) {
+        width_ = width;
+        height_ = height;
+        counts_.assign(static_cast<size_t>(width_) * height_, 0);
+        pixels_.assign(counts_.size(), 0);
+        if (heatmap_) SDL_DestroyTexture(heatmap_);
+        heatmap_ = nullptr;
+    }
+    rects_.clear();
+
+    if (!window_) {
+        window_ = SDL_RenderGetWindow(renderer);
+        if (window_) windowTitle_ = SDL_GetWindowTitle(window_);
+    }
+}
+
+void OverdrawMap::EndFrame(SDL_Renderer* renderer) {
+    if (!capturing_) return;
+    capturing_ = false;
+
+    Replay();
+    DrawHeatmap(renderer);
+}
+
+void OverdrawMap::Record(const SDL_Rect* rect) {
+    if (!capturing_) return;
+
+    SDL_Rect bounds = {0, 0, width_, height_};
+    SDL_Rect clipped;
+    if (!rect) {
+        rects_.push_back(bounds);
+    } else if (SDL_IntersectRect(rect, &bounds, &clipped)) {
+        rects_.push_back(clipped);
+    }
+}
+
+void OverdrawMap::Record(const SDL_FRect& rect) {
+    if (!capturing_) return;
+
+    int left = static_cast<int>(std::floor(std::min(rect.x, rect.x + rect.w)));
+    int top = static_cast<int>(std::floor(std::min(rect.y, rect.y + rect.h)));
+    int right = static_cast<int>(std::ceil(std::max(rect.x, rect.x + rect.w)));
+    int bottom = static_cast<int>(std::ceil(std::max(rect.y, rect.y + rect.h)));
+    SDL_Rect covered = {left, top, right - left, bottom - top};
+    Record(&covered);
+}
+
+void OverdrawMap::Replay() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    for (const auto& rect : rects_) {
+        for (int y = rect.y; y < rect.y + rect.h; y++) {
+            uint16_t* row = counts_.data() + static_cast<size_t>(y) * width_;
+            for (int x = rect.x; x < rect.x + rect.w; x++) {
+                if (row[x] < UINT16_MAX) row[x]++;
+            }
+        }
+    }
+}
+
+void OverdrawMap::DrawHeatmap(SDL_Renderer* renderer) {
+    if (counts_.empty()) return;
+
+    uint64_t total = 0;
+    uint16_t peak = 0;
+    for (size_t i = 0; i < counts_.size(); i++) {
+        total += counts_[i];
+        peak = std::max(peak, counts_[i]);
+        pixels_[i] = HEAT_COLORS[std::min<int>(counts_[i], MAX_LEVEL)];
+    }
+
+    if (!heatmap_) {
+        heatmap_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width_, height_);
+        if (!heatmap_) return;
+        SDL_SetTextureBlendMode(heatmap_, SDL_BLENDMODE_NONE);
+    }
+    SDL_UpdateTexture(heatmap_, nullptr, pixels_.data(), width_ * static_cast<int>(sizeof(Uint32)));
+    SDL_RenderCopy(renderer, heatmap_, nullptr, nullptr);
+
+    if (window_) {
+        char title[128];
+        std::snprintf(title, sizeof(title), "Overdraw: avg %.2fx, max %dx, %zu draws",
+                      static_cast<double>(total) / counts_.size(), peak, rects_.size());
+        SDL_SetWindowTitle(window_, title);
+    }
+}
+
+int OverdrawMap::Copy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* dest) {
+    GetInstance().Record(dest);
+    return SDL_RenderCopy(renderer, texture, source, dest);
+}
+
+int OverdrawMap::CopyEx(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* dest,
+                        double angle, const SDL_Point* center, SDL_RendererFlip flip) {
+    // Rotated copies count their unrotated rectangle; none of ours rotate much.
+    GetInstance().Record(dest);
+    return SDL_RenderCopyEx(renderer, texture, source, dest, angle, center, flip);
+}
+
+int OverdrawMap::CopyExF(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_FRect* dest,
+                         double angle, const SDL_FPoint* center, SDL_RendererFlip flip) {
+    if (dest) {
+        GetInstance().Record(*dest);
+    } else {
+        GetInstance().Record(nullptr);
+    }
+    return SDL_RenderCopyExF(renderer, texture, source, dest, angle, center, flip);
+}
+
+int OverdrawMap::FillRect(SDL_Renderer* renderer, const SDL_Rect* rect) {
+    GetInstance().Record(rect);
+    return SDL_RenderFillRect(renderer, rect);
+}
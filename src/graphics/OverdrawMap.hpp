@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Debug view of fill-rate waste. Game code draws through the wrappers below,
+// which forward to SDL and, while the view is on, also record the covered
+// rectangle. EndFrame replays those rectangles into a per-pixel counter,
+// draws the counts over the frame as a heatmap and shows the average and
+// maximum overdraw in the window title.
+class OverdrawMap {
+public:
+    static OverdrawMap& GetInstance();
+
+    void Toggle();
+    bool IsEnabled() const { return enabled_; }
+    // Frees the heatmap texture; call before the renderer is destroyed.
+    void Shutdown();
+
+    void BeginFrame(SDL_Renderer* renderer);
+    void EndFrame(SDL_Renderer* renderer);
+
+    void Record(const SDL_Rect* rect);
+    void Record(const SDL_FRect& rect);
+
+    static int Copy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* dest);
+    static int CopyEx(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* dest,
+                      double angle, const SDL_Point* center, SDL_RendererFlip flip);
+    static int CopyExF(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_FRect* dest,
+                       double angle, const SDL_FPoint* center, SDL_RendererFlip flip);
+    static int FillRect(SDL_Renderer* renderer, const SDL_Rect* rect);
+
+    static constexpr int MAX_LEVEL = 8;
+
+private:
+    OverdrawMap() = default;
+    ~OverdrawMap() = default;
+    OverdrawMap(const OverdrawMap&) = delete;
+    OverdrawMap& operator=(const OverdrawMap&) = delete;
+
+    void Release();
+    void Replay();
+    void DrawHeatmap(SDL_Renderer* renderer);
+
+    bool enabled_ = false;
+    bool capturing_ = false;
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<SDL_Rect> rects_;
+    std::vector<uint16_t> counts_;
+    std::vector<Uint32> pixels_;
+    SDL_Texture* heatmap_ = nullptr;
+    SDL_Window* window_ = nullptr;
+    std::string windowTitle_;
+};
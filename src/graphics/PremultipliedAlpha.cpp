@@ -0,0 +1,155 @@
+#include "PremultipliedAlpha.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PREMULTIPLY_SSE2 1
+#include <immintrin.h>
+#endif
+
+#if defined(PREMULTIPLY_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define PREMULTIPLY_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define PREMULTIPLY_AVX2_TARGET
+#endif
+
+namespace {
+    // x * a / 255, rounded, for x and a in 0..255.
+    inline Uint32 MultiplyChannel(Uint32 x, Uint32 a) {
+        Uint32 t = x * a + 128;
+        return (t + (t >> 8)) >> 8;
+    }
+
+#ifdef PREMULTIPLY_SSE2
+    // Pixels are B, G, R, A bytes in memory. Each is widened to 16 bits,
+    // multiplied by its alpha (by 255 in the alpha lane) and divided by 255
+    // with the same rounding as the scalar path.
+    inline __m128i Premultiply4(__m128i pixels, __m128i zero, __m128i colorMask, __m128i alphaOne, __m128i half) {
+        __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+        __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        alphaLo = _mm_or_si128(_mm_and_si128(alphaLo, colorMask), alphaOne);
+        alphaHi = _mm_or_si128(_mm_and_si128(alphaHi, colorMask), alphaOne);
+
+        lo = _mm_add_epi16(_mm_mullo_epi16(lo, alphaLo), half);
+        hi = _mm_add_epi16(_mm_mullo_epi16(hi, alphaHi), half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        return _mm_packus_epi16(lo, hi);
+    }
+
+    size_t ConvertSse2(Uint32* pixels, size_t count) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+        const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+        const __m128i half = _mm_set1_epi16(128);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i* block = reinterpret_cast<__m128i*>(pixels + i);
+            _mm_storeu_si128(block, Premultiply4(_mm_loadu_si128(block), zero, colorMask, alphaOne, half));
+        }
+        return i;
+    }
+
+    PREMULTIPLY_AVX2_TARGET size_t ConvertAvx2(Uint32* pixels, size_t count) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i colorMask = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+        const __m256i alphaOne = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+        const __m256i half = _mm256_set1_epi16(128);
+
+        // Unpack and pack work within 128-bit lanes, so pixel order survives.
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i* block = reinterpret_cast<__m256i*>(pixels + i);
+            __m256i source = _mm256_loadu_si256(block);
+            __m256i lo = _mm256_unpacklo_epi8(source, zero);
+            __m256i hi = _mm256_unpackhi_epi8(source, zero);
+
+            __m256i alphaLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m256i alphaHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            alphaLo = _mm256_or_si256(_mm256_and_si256(alphaLo, colorMask), alphaOne);
+            alphaHi = _mm256_or_si256(_mm256_and_si256(alphaHi, colorMask), alphaOne);
+
+            lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, alphaLo), half);
+            hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, alphaHi), half);
+            lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+            hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+            _mm256_storeu_si256(block, _mm256_packus_epi16(lo, hi));
+        }
+        return i;
+    }
+#endif
+}
+
+void PremultipliedAlpha::ConvertScalar(Uint32* pixels, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        Uint32 pixel = pixels[i];
+        Uint32 a = pixel >> 24;
+        if (a == 255) continue;
+        pixels[i] = (a << 24)
+                  | (MultiplyChannel((pixel >> 16) & 0xFF, a) << 16)
+                  | (MultiplyChannel((pixel >> 8) & 0xFF, a) << 8)
+                  | MultiplyChannel(pixel & 0xFF, a);
+    }
+}
+
+void PremultipliedAlpha::Convert(Uint32* pixels, size_t count) {
+    size_t done = 0;
+#ifdef PREMULTIPLY_SSE2
+    static const bool hasAvx2 = SDL_HasAVX2() == SDL_TRUE;
+    done = hasAvx2 ? ConvertAvx2(pixels, count) : ConvertSse2(pixels, count);
+#endif
+    ConvertScalar(pixels + done, count - done);
+}
+
+bool PremultipliedAlpha::Convert(SDL_Surface* surface) {
+    if (!surface || surface->format->format != SDL_PIXELFORMAT_ARGB8888) return false;
+
+    if (SDL_MUSTLOCK(surface)) SDL_LockSurface(surface);
+    Uint8* row = static_cast<Uint8*>(surface->pixels);
+    if (surface->pitch == surface->w * static_cast<int>(sizeof(Uint32))) {
+        Convert(reinterpret_cast<Uint32*>(row), static_cast<size_t>(surface->w) * surface->h);
+    } else {
+        for (int y = 0; y < surface->h; y++, row += surface->pitch) {
+            Convert(reinterpret_cast<Uint32*>(row), surface->w);
+        }
+    }
+    if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+    return true;
+}
+
+SDL_BlendMode PremultipliedAlpha::GetBlendMode() {
+    static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    return mode;
+}
+
+bool PremultipliedAlpha::IsSupported(SDL_Renderer* renderer) {
+    static SDL_Renderer* checked = nullptr;
+    static bool supported = false;
+    if (renderer == checked) return supported;
+
+    // SDL has no query for this; the software renderer rejects custom modes.
+    checked = renderer;
+    supported = false;
+    SDL_Texture* probe = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    if (probe) {
+        supported = SDL_SetTextureBlendMode(probe, GetBlendMode()) == 0;
+        SDL_DestroyTexture(probe);
+    }
+    return supported;
+}
+
+void PremultipliedAlpha::SetOpacity(SDL_Texture* texture, Uint8 alpha) {
+    SDL_SetTextureAlphaMod(texture, alpha);
+    if (IsPremultiplied(texture)) {
+        SDL_SetTextureColorMod(texture, alpha, alpha, alpha);
+    }
+}
+
+bool PremultipliedAlpha::IsPremultiplied(SDL_Texture* texture) {
+    SDL_BlendMode mode = SDL_BLENDMODE_NONE;
+    return texture && SDL_GetTextureBlendMode(texture, &mode) == 0 && mode == GetBlendMode();
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+// Load-time conversion of ARGB8888 pixels to premultiplied alpha, and the
+// matching blend mode. Premultiplied texels filter correctly when scaled, so
+// downscaled sprites lose the dark fringe straight alpha gives them. Only
+// renderers that accept custom blend modes get premultiplied textures.
+class PremultipliedAlpha {
+public:
+    static void Convert(Uint32* pixels, size_t count);
+    static bool Convert(SDL_Surface* surface);
+
+    static SDL_BlendMode GetBlendMode();
+    static bool IsSupported(SDL_Renderer* renderer);
+
+    // Alpha mod alone leaves premultiplied colour at full strength, so
+    // fading scales the colour mod with it.
+    static void SetOpacity(SDL_Texture* texture, Uint8 alpha);
+    static bool IsPremultiplied(SDL_Texture* texture);
+
+private:
+    static void ConvertScalar(Uint32* pixels, size_t count);
+};
@@ -0,0 +1,66 @@
+#include "SpriteBatch.hpp"
+#include "OverdrawMap.hpp"
+#include <utility>
+
+SpriteBatch::SpriteBatch(SDL_Renderer* renderer)
+    : renderer_(renderer)
+{
+    vertices_.reserve(4 * 256);
+    indices_.reserve(6 * 256);
+}
+
+void SpriteBatch::Begin() {
+    texture_ = nullptr;
+    vertices_.clear();
+    indices_.clear();
+}
+
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_Rect& source, const SDL_FRect& dest,
+                       SDL_Color color, bool flipX) {
+    if (!texture) return;
+    OverdrawMap::GetInstance().Record(dest);
+
+    if (texture != texture_) {
+        Flush();
+        texture_ = texture;
+        int w = 0, h = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+        invTextureW_ = w > 0 ? 1.0f / w : 0.0f;
+        invTextureH_ = h > 0 ? 1.0f / h : 0.0f;
+    }
+
+    float u0 = source.x * invTextureW_;
+    float v0 = source.y * invTextureH_;
+    float u1 = (source.x + source.w) * invTextureW_;
+    float v1 = (source.y + source.h) * invTextureH_;
+    if (flipX) {
+        std::swap(u0, u1);
+    }
+
+    int base = static_cast<int>(vertices_.size());
+    vertices_.push_back({{dest.x, dest.y}, color, {u0, v0}});
+    vertices_.push_back({{dest.x + dest.w, dest.y}, color, {u1, v0}});
+    vertices_.push_back({{dest.x + dest.w, dest.y + dest.h}, color, {u1, v1}});
+    vertices_.push_back({{dest.x, dest.y + dest.h}, color, {u0, v1}});
+
+    indices_.push_back(base);
+    indices_.push_back(base + 1);
+    indices_.push_back(base + 2);
+    indices_.push_back(base);
+    indices_.push_back(base + 2);
+    indices_.push_back(base + 3);
+}
+
+void SpriteBatch::End() {
+    Flush();
+    texture_ = nullptr;
+}
+
+void SpriteBatch::Flush() {
+    if (vertices_.empty()) return;
+
+    SDL_RenderGeometry(renderer_, texture_, vertices_.data(), static_cast<int>(vertices_.size()),
+                       indices_.data(), static_cast<int>(indices_.size()));
+    vertices_.clear();
+    indices_.clear();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Collects textured quads and submits each run of same-texture quads with a
+// single SDL_RenderGeometry call.
+class SpriteBatch {
+public:
+    explicit SpriteBatch(SDL_Renderer* renderer);
+
+    void Begin();
+    void Draw(SDL_Texture* texture, const SDL_Rect& source, const SDL_FRect& dest,
+              SDL_Color color = {255, 255, 255, 255}, bool flipX = false);
+    void End();
+
+    SDL_Renderer* GetRenderer() const { return renderer_; }
+
+private:
+    void Flush();
+
+    SDL_Renderer* renderer_;
+    SDL_Texture* texture_ = nullptr;
+    float invTextureW_ = 0.0f;
+    float invTextureH_ = 0.0f;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+};
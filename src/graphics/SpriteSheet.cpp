@@ -0,0 +1,219 @@
+#include "SpriteSheet.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+namespace {
+    bool IsInteger(const nlohmann::json& object, const char* key) {
+        auto value = object.find(key);
+        return value != object.end() && value->is_number_integer();
+    }
+
+    bool IsValidFrame(const SpriteFrame& frame, int cellWidth, int cellHeight, int textureWidth, int textureHeight) {
+        // Trim writes cells without opaque pixels as an all-zero frame, which
+        // Draw skips.
+        const SDL_Rect& source = frame.source;
+        if (source.x == 0 && source.y == 0 && source.w == 0 && source.h == 0 && frame.offsetX == 0 && frame.offsetY == 0) {
+            return true;
+        }
+        return source.w > 0 && source.h > 0 && source.x >= 0 && source.y >= 0 &&
+               source.x + source.w <= textureWidth && source.y + source.h <= textureHeight &&
+               frame.offsetX >= 0 && frame.offsetY >= 0 &&
+               frame.offsetX + source.w <= cellWidth && frame.offsetY + source.h <= cellHeight;
+    }
+}
+
+void SpriteSheet::SetGrid(int cellWidth, int cellHeight, int frameCount, int columns) {
+    cellWidth_ = cellWidth;
+    cellHeight_ = cellHeight;
+    if (columns <= 0) columns = frameCount;
+
+    frames_.assign(frameCount, SpriteFrame());
+    for (int i = 0; i < frameCount; i++) {
+        frames_[i].source = {(i % columns) * cellWidth, (i / columns) * cellHeight, cellWidth, cellHeight};
+    }
+    trimmed_ = false;
+}
+
+bool SpriteSheet::Load(const std::string& path, int textureWidth, int textureHeight) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    // Layouts can come from mods, so every field is checked before use.
+    nlohmann::json layout = nlohmann::json::parse(file, nullptr, false);
+    if (layout.is_discarded() || !layout.is_object() || !layout.contains("frames") || !layout["frames"].is_array() ||
+        !IsInteger(layout, "cellWidth") || !IsInteger(layout, "cellHeight")) {
+        std::cerr << "Invalid sprite sheet layout: " << path << std::endl;
+        return false;
+    }
+
+    int cellWidth = layout["cellWidth"].get<int>();
+    int cellHeight = layout["cellHeight"].get<int>();
+    if (cellWidth <= 0 || cellHeight <= 0) {
+        std::cerr << "Invalid sprite sheet cell size in " << path << std::endl;
+        return false;
+    }
+
+    std::vector<SpriteFrame> frames;
+    for (const auto& entry : layout["frames"]) {
+        if (!entry.is_object() || !IsInteger(entry, "x") || !IsInteger(entry, "y") || !IsInteger(entry, "w") ||
+            !IsInteger(entry, "h") || (entry.contains("offsetX") && !IsInteger(entry, "offsetX")) ||
+            (entry.contains("offsetY") && !IsInteger(entry, "offsetY"))) {
+            std::cerr << "Invalid sprite sheet frame in " << path << ": " << entry.dump() << std::endl;
+            return false;
+        }
+
+        SpriteFrame frame;
+        frame.source = {entry["x"].get<int>(), entry["y"].get<int>(), entry["w"].get<int>(), entry["h"].get<int>()};
+        frame.offsetX = entry.value("offsetX", 0);
+        frame.offsetY = entry.value("offsetY", 0);
+        if (!IsValidFrame(frame, cellWidth, cellHeight, textureWidth, textureHeight)) {
+            std::cerr << "Sprite sheet frame " << frames.size() << " is out of bounds in " << path << std::endl;
+            return false;
+        }
+        frames.push_back(frame);
+    }
+
+    cellWidth_ = cellWidth;
+    cellHeight_ = cellHeight;
+    frames_ = std::move(frames);
+    trimmed_ = true;
+    return true;
+}
+
+bool SpriteSheet::Save(const std::string& path) const {
+    nlohmann::json layout;
+    layout["cellWidth"] = cellWidth_;
+    layout["cellHeight"] = cellHeight_;
+    layout["frames"] = nlohmann::json::array();
+    for (const auto& frame : frames_) {
+        layout["frames"].push_back({
+            {"x", frame.source.x}, {"y", frame.source.y}, {"w", frame.source.w}, {"h", frame.source.h},
+            {"offsetX", frame.offsetX}, {"offsetY", frame.offsetY}
+        });
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write sprite sheet layout: " << path << std::endl;
+        return false;
+    }
+    file << layout.dump(1) << std::endl;
+    return true;
+}
+
+SDL_Rect SpriteSheet::FindOpaqueBounds(SDL_Surface* surface, const SDL_Rect& cell) {
+    int minX = cell.w, minY = cell.h, maxX = -1, maxY = -1;
+    for (int y = 0; y < cell.h; y++) {
+        const Uint32* row = reinterpret_cast<const Uint32*>(
+            static_cast<const Uint8*>(surface->pixels) + (cell.y + y) * surface->pitch) + cell.x;
+        for (int x = 0; x < cell.w; x++) {
+            if ((row[x] >> 24) == 0) continue;
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = y;
+        }
+    }
+
+    if (maxX < 0) return {0, 0, 0, 0};
+    return {minX, minY, maxX - minX + 1, maxY - minY + 1};
+}
+
+SDL_Surface* SpriteSheet::Trim(SDL_Surface* sheet) {
+    SDL_Surface* source = SDL_ConvertSurfaceFormat(sheet, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!source) return nullptr;
+
+    std::vector<SDL_Rect> bounds(frames_.size());
+    int area = 0;
+    int widest = 0;
+    for (size_t i = 0; i < frames_.size(); i++) {
+        bounds[i] = FindOpaqueBounds(source, frames_[i].source);
+        area += (bounds[i].w + PADDING) * (bounds[i].h + PADDING);
+        widest = std::max(widest, bounds[i].w + PADDING);
+    }
+
+    // Shelf-pack tallest first into a roughly square sheet.
+    std::vector<size_t> order(frames_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&bounds](size_t a, size_t b) { return bounds[a].h > bounds[b].h; });
+
+    int sheetWidth = std::max(widest, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area)))));
+    std::vector<SDL_Point> positions(frames_.size());
+    int x = 0, y = 0, shelfHeight = 0;
+    for (size_t i : order) {
+        if (bounds[i].w == 0) continue;
+        if (x + bounds[i].w + PADDING > sheetWidth) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        positions[i] = {x, y};
+        x += bounds[i].w + PADDING;
+        shelfHeight = std::max(shelfHeight, bounds[i].h + PADDING);
+    }
+    int sheetHeight = std::max(1, y + shelfHeight);
+
+    SDL_Surface* packed = SDL_CreateRGBSurfaceWithFormat(0, sheetWidth, sheetHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!packed) {
+        SDL_FreeSurface(source);
+        return nullptr;
+    }
+    SDL_FillRect(packed, nullptr, 0);
+    SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+
+    for (size_t i = 0; i < frames_.size(); i++) {
+        SpriteFrame& frame = frames_[i];
+        if (bounds[i].w == 0) {
+            frame = SpriteFrame();
+            continue;
+        }
+
+        SDL_Rect from = {frame.source.x + bounds[i].x, frame.source.y + bounds[i].y, bounds[i].w, bounds[i].h};
+        SDL_Rect to = {positions[i].x, positions[i].y, bounds[i].w, bounds[i].h};
+        SDL_BlitSurface(source, &from, packed, &to);
+
+        frame.source = to;
+        frame.offsetX = bounds[i].x;
+        frame.offsetY = bounds[i].y;
+    }
+
+    SDL_FreeSurface(source);
+    trimmed_ = true;
+    return packed;
+}
+
+SDL_FRect SpriteSheet::Draw(SDL_Renderer* renderer, SDL_Texture* texture, int frame, const SDL_Rect& cell,
+                            SDL_RendererFlip flip) const {
+    if (frame < 0 || frame >= GetFrameCount() || cellWidth_ <= 0 || cellHeight_ <= 0) return {0, 0, 0, 0};
+
+    const SpriteFrame& sprite = frames_[frame];
+    if (sprite.source.w == 0 || sprite.source.h == 0) return {0, 0, 0, 0};
+
+    // Flipping mirrors the crop's position within the cell as well as its pixels.
+    int offsetX = (flip & SDL_FLIP_HORIZONTAL) ? cellWidth_ - sprite.offsetX - sprite.source.w : sprite.offsetX;
+    int offsetY = (flip & SDL_FLIP_VERTICAL) ? cellHeight_ - sprite.offsetY - sprite.source.h : sprite.offsetY;
+    float scaleX = static_cast<float>(cell.w) / cellWidth_;
+    float scaleY = static_cast<float>(cell.h) / cellHeight_;
+
+    SDL_FRect destination = {
+        cell.x + offsetX * scaleX,
+        cell.y + offsetY * scaleY,
+        sprite.source.w * scaleX,
+        sprite.source.h * scaleY
+    };
+    SDL_RenderCopyExF(renderer, texture, &sprite.source, &destination, 0.0, nullptr, flip);
+    return destination;
+}
+
+std::string SpriteSheet::GetLayoutPath(const std::string& imagePath) {
+    size_t extension = imagePath.find_last_of('.');
+    size_t separator = imagePath.find_last_of("/\\");
+    if (extension == std::string::npos || (separator != std::string::npos && extension < separator)) {
+        return imagePath + ".sheet.json";
+    }
+    return imagePath.substr(0, extension) + ".sheet.json";
+}
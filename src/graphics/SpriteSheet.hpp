@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+struct SpriteFrame {
+    SDL_Rect source = {0, 0, 0, 0};
+    int offsetX = 0;
+    int offsetY = 0;
+};
+
+// Frame layout for a sheet of fixed-size animation cells. A plain sheet is
+// a grid; a trimmed sheet stores each frame cropped to its opaque bounds,
+// packed, with the crop's offset inside the original cell. Draw places the
+// cropped rectangle where it sat in the cell, so callers keep working in
+// cell coordinates either way.
+class SpriteSheet {
+public:
+    void SetGrid(int cellWidth, int cellHeight, int frameCount, int columns = 0);
+    // Rejects layouts with mistyped fields or frames that fall outside the
+    // texture or their cell; the current layout is kept on failure.
+    bool Load(const std::string& path, int textureWidth, int textureHeight);
+    bool Save(const std::string& path) const;
+
+    // Crops every frame of a grid sheet and packs the results into a new
+    // surface, replacing the layout with the trimmed one.
+    SDL_Surface* Trim(SDL_Surface* sheet);
+
+    // Returns the rectangle drawn to, empty when the frame has no pixels.
+    SDL_FRect Draw(SDL_Renderer* renderer, SDL_Texture* texture, int frame, const SDL_Rect& cell,
+                   SDL_RendererFlip flip = SDL_FLIP_NONE) const;
+
+    int GetCellWidth() const { return cellWidth_; }
+    int GetCellHeight() const { return cellHeight_; }
+    int GetFrameCount() const { return static_cast<int>(frames_.size()); }
+    const SpriteFrame& GetFrame(int frame) const { return frames_[frame]; }
+    bool IsTrimmed() const { return trimmed_; }
+
+    static std::string GetLayoutPath(const std::string& imagePath);
+
+    static constexpr int PADDING = 1;
+
+private:
+    static SDL_Rect FindOpaqueBounds(SDL_Surface* surface, const SDL_Rect& cell);
+
+    int cellWidth_ = 0;
+    int cellHeight_ = 0;
+    std::vector<SpriteFrame> frames_;
+    bool trimmed_ = false;
+};
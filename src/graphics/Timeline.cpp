@@ -0,0 +1,148 @@
+#include "Timeline.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+    constexpr float HALF_PI = 1.57079632679f;
+
+    Interpolation ParseInterpolation(const std::string& name) {
+        if (name == "step") return Interpolation::Step;
+        if (name == "sinein") return Interpolation::SineIn;
+        if (name == "sineout") return Interpolation::SineOut;
+        return Interpolation::Linear;
+    }
+
+    float Ease(Interpolation interpolation, float t) {
+        switch (interpolation) {
+            case Interpolation::Step: return 0.0f;
+            case Interpolation::SineIn: return 1.0f - std::cos(t * HALF_PI);
+            case Interpolation::SineOut: return std::sin(t * HALF_PI);
+            default: return t;
+        }
+    }
+}
+
+int Timeline::AddTrack(const std::string& name, const std::vector<Keyframe>& keyframes) {
+    int track = FindTrack(name);
+    if (track < 0) {
+        names_.push_back(name);
+        keyframes_.push_back(keyframes);
+        track = static_cast<int>(names_.size()) - 1;
+    } else {
+        keyframes_[track] = keyframes;
+    }
+
+    Bake();
+    return track;
+}
+
+bool Timeline::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    nlohmann::json data = nlohmann::json::parse(file, nullptr, false);
+    if (data.is_discarded() || !data.is_object()) {
+        std::cerr << "Invalid timeline: " << path << std::endl;
+        return false;
+    }
+
+    // Each track is a list of [tick, value, "interpolation"] entries. The
+    // whole file is checked first, so a bad key keeps the built-in tracks.
+    std::vector<std::pair<std::string, std::vector<Keyframe>>> tracks;
+    for (const auto& track : data.items()) {
+        if (FindTrack(track.key()) < 0) continue;
+        if (!track.value().is_array()) {
+            std::cerr << "Invalid timeline track in " << path << ": " << track.key() << std::endl;
+            return false;
+        }
+
+        std::vector<Keyframe> keyframes;
+        for (const auto& key : track.value()) {
+            if (!key.is_array() || key.size() < 2 || !key[0].is_number_integer() || !key[1].is_number() ||
+                (key.size() > 2 && !key[2].is_string())) {
+                std::cerr << "Invalid timeline key in " << path << ", track " << track.key() << ": "
+                          << key.dump() << std::endl;
+                return false;
+            }
+            Keyframe keyframe;
+            keyframe.tick = key[0].get<int>();
+            keyframe.value = key[1].get<float>();
+            if (key.size() > 2) {
+                keyframe.interpolation = ParseInterpolation(key[2].get<std::string>());
+            }
+            keyframes.push_back(keyframe);
+        }
+
+        if (!keyframes.empty()) {
+            tracks.emplace_back(track.key(), std::move(keyframes));
+        }
+    }
+
+    for (auto& track : tracks) {
+        keyframes_[FindTrack(track.first)] = std::move(track.second);
+    }
+
+    Bake();
+    return true;
+}
+
+int Timeline::FindTrack(const std::string& name) const {
+    for (size_t i = 0; i < names_.size(); i++) {
+        if (names_[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void Timeline::Evaluate(int tick) {
+    size_t count = values_.size();
+    for (size_t i = 0; i < count; i++) {
+        uint32_t index = static_cast<uint32_t>(std::max(tick, 0));
+        if (index >= lengths_[i]) index = lengths_[i] - 1;
+        values_[i] = samples_[offsets_[i] + index];
+    }
+}
+
+float Timeline::Sample(int track, int tick) const {
+    uint32_t index = static_cast<uint32_t>(std::max(tick, 0));
+    if (index >= lengths_[track]) index = lengths_[track] - 1;
+    return samples_[offsets_[track] + index];
+}
+
+void Timeline::Bake() {
+    offsets_.clear();
+    lengths_.clear();
+    samples_.clear();
+    duration_ = 0;
+
+    for (auto& keyframes : keyframes_) {
+        std::stable_sort(keyframes.begin(), keyframes.end(),
+            [](const Keyframe& a, const Keyframe& b) { return a.tick < b.tick; });
+
+        int last = keyframes.empty() ? 0 : std::max(keyframes.back().tick, 0);
+        offsets_.push_back(static_cast<uint32_t>(samples_.size()));
+        lengths_.push_back(static_cast<uint32_t>(last + 1));
+        duration_ = std::max(duration_, last);
+
+        size_t key = 0;
+        for (int tick = 0; tick <= last; tick++) {
+            while (key + 1 < keyframes.size() && keyframes[key + 1].tick <= tick) {
+                key++;
+            }
+
+            float value = keyframes.empty() ? 0.0f : keyframes[key].value;
+            if (key + 1 < keyframes.size() && tick >= keyframes[key].tick) {
+                const Keyframe& from = keyframes[key];
+                const Keyframe& to = keyframes[key + 1];
+                float t = static_cast<float>(tick - from.tick) / (to.tick - from.tick);
+                value = from.value + (to.value - from.value) * Ease(from.interpolation, t);
+            }
+            samples_.push_back(value);
+        }
+    }
+
+    values_.assign(names_.size(), 0.0f);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class Interpolation {
+    Step,
+    Linear,
+    SineIn,
+    SineOut
+};
+
+struct Keyframe {
+    int tick;
+    float value;
+    Interpolation interpolation = Interpolation::Linear;
+};
+
+// Named keyframe tracks baked into one table of per-tick samples. Tracks added
+// in code can be overridden from a JSON file; tracks the file names that were
+// never added are ignored, so timelines sharing a file only take their own.
+// Evaluating the timeline is a table read per track with no allocation.
+class Timeline {
+public:
+    int AddTrack(const std::string& name, const std::vector<Keyframe>& keyframes);
+    bool Load(const std::string& path);
+
+    int FindTrack(const std::string& name) const;
+    int GetDuration() const { return duration_; }
+
+    void Evaluate(int tick);
+    float Get(int track) const { return values_[track]; }
+    float Sample(int track, int tick) const;
+
+private:
+    void Bake();
+
+    std::vector<std::string> names_;
+    std::vector<std::vector<Keyframe>> keyframes_;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> lengths_;
+    std::vector<float> samples_;
+    std::vector<float> values_;
+    int duration_ = 0;
+};
@@ -0,0 +1,20 @@
+#include "TransitionLayer.hpp"
+#include "OverdrawMap.hpp"
+#include <algorithm>
+
+void TransitionLayer::SetOverlay(SDL_Color color, float opacity) {
+    color_ = color;
+    alpha_ = static_cast<Uint8>(std::clamp(opacity, 0.0f, 1.0f) * color.a);
+}
+
+void TransitionLayer::Render(SDL_Renderer* renderer) const {
+    if (!IsActive()) return;
+
+    // An opaque overlay replaces the frame, so it can skip blending too.
+    SDL_BlendMode previous = SDL_BLENDMODE_BLEND;
+    SDL_GetRenderDrawBlendMode(renderer, &previous);
+    SDL_SetRenderDrawBlendMode(renderer, IsOpaque() ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, color_.r, color_.g, color_.b, alpha_);
+    OverdrawMap::FillRect(renderer, nullptr);
+    SDL_SetRenderDrawBlendMode(renderer, previous);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Full-screen colour overlay for fades and flashes, drawn after the scene.
+// States ask IsSceneVisible before rendering: once the overlay is opaque the
+// scene underneath cannot be seen, so it is not drawn at all.
+class TransitionLayer {
+public:
+    void SetOverlay(SDL_Color color, float opacity);
+    void Clear() { alpha_ = 0; }
+
+    bool IsActive() const { return alpha_ > 0; }
+    bool IsOpaque() const { return alpha_ == 255; }
+    bool IsSceneVisible() const { return !IsOpaque(); }
+
+    void Render(SDL_Renderer* renderer) const;
+
+private:
+    SDL_Color color_ = {0, 0, 0, 255};
+    Uint8 alpha_ = 0;
+};
@@ -0,0 +1,117 @@
+#include "UploadQueue.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+UploadQueue& UploadQueue::GetInstance() {
+    static UploadQueue instance;
+    return instance;
+}
+
+void UploadQueue::Shutdown() {
+    for (auto& job : now_) Release(job);
+    for (auto& job : prefetch_) Release(job);
+    now_.clear();
+    prefetch_.clear();
+}
+
+uint64_t UploadQueue::Enqueue(SDL_Surface* surface, UploadPriority priority, Callback callback) {
+    if (!surface) return 0;
+
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        surface = converted;
+        if (!surface) return 0;
+    }
+
+    Job job;
+    job.id = nextId_++;
+    job.surface = surface;
+    job.callback = std::move(callback);
+    (priority == UploadPriority::Now ? now_ : prefetch_).push_back(std::move(job));
+    return nextId_ - 1;
+}
+
+void UploadQueue::Cancel(uint64_t id) {
+    for (auto* queue : {&now_, &prefetch_}) {
+        auto job = std::find_if(queue->begin(), queue->end(), [id](const Job& j) { return j.id == id; });
+        if (job != queue->end()) {
+            Release(*job);
+            queue->erase(job);
+            return;
+        }
+    }
+}
+
+void UploadQueue::Process(SDL_Renderer* renderer) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 limit = static_cast<Uint64>(budget_.milliseconds * SDL_GetPerformanceFrequency() / 1000.0);
+    size_t spent = 0;
+
+    // Always make some progress, even if the budget is smaller than one band.
+    while (!IsIdle()) {
+        std::deque<Job>& queue = now_.empty() ? prefetch_ : now_;
+        spent += Step(renderer, queue, std::max<size_t>(budget_.bytes - std::min(spent, budget_.bytes), 1));
+        if (spent >= budget_.bytes || SDL_GetPerformanceCounter() - start >= limit) break;
+    }
+}
+
+void UploadQueue::Flush(SDL_Renderer* renderer) {
+    while (!IsIdle()) {
+        Step(renderer, now_.empty() ? prefetch_ : now_, std::numeric_limits<size_t>::max());
+    }
+}
+
+size_t UploadQueue::Step(SDL_Renderer* renderer, std::deque<Job>& queue, size_t byteLimit) {
+    Job& job = queue.front();
+    SDL_Surface* surface = job.surface;
+
+    if (!job.texture) {
+        job.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, surface->w, surface->h);
+        if (!job.texture) {
+            std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
+            Callback callback = std::move(job.callback);
+            Release(job);
+            queue.pop_front();
+            if (callback) callback(nullptr);
+            return 0;
+        }
+        SDL_SetTextureBlendMode(job.texture, SDL_BLENDMODE_BLEND);
+    }
+
+    // Upload in bands of whole rows so one large image spreads over frames.
+    int rows = static_cast<int>(std::min<size_t>(byteLimit / static_cast<size_t>(surface->pitch),
+                                                 static_cast<size_t>(surface->h - job.nextRow)));
+    rows = std::max(rows, 1);
+    SDL_Rect band = {0, job.nextRow, surface->w, rows};
+    SDL_UpdateTexture(job.texture, &band, static_cast<Uint8*>(surface->pixels) + static_cast<size_t>(job.nextRow) * surface->pitch,
+                      surface->pitch);
+    job.nextRow += rows;
+    size_t bytes = static_cast<size_t>(rows) * surface->pitch;
+
+    if (job.nextRow >= surface->h) {
+        SDL_Texture* texture = job.texture;
+        Callback callback = std::move(job.callback);
+        job.texture = nullptr;
+        Release(job);
+        queue.pop_front();
+        if (callback) {
+            callback(texture);
+        } else {
+            SDL_DestroyTexture(texture);
+        }
+    }
+    return bytes;
+}
+
+void UploadQueue::Release(Job& job) {
+    if (job.surface) {
+        SDL_FreeSurface(job.surface);
+        job.surface = nullptr;
+    }
+    if (job.texture) {
+        SDL_DestroyTexture(job.texture);
+        job.texture = nullptr;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+enum class UploadPriority {
+    Now,
+    Prefetch
+};
+
+// Turns decoded surfaces into textures a few rows at a time, spending at most
+// a fixed time and byte budget per frame. Surfaces the current state needs
+// now go ahead of prefetches; the callback only sees fully uploaded textures.
+// Main thread only.
+class UploadQueue {
+public:
+    struct Budget {
+        double milliseconds = 2.0;
+        size_t bytes = 8 * 1024 * 1024;
+    };
+
+    using Callback = std::function<void(SDL_Texture*)>;
+
+    static UploadQueue& GetInstance();
+
+    uint64_t Enqueue(SDL_Surface* surface, UploadPriority priority, Callback callback);
+    void Cancel(uint64_t id);
+
+    void Process(SDL_Renderer* renderer);
+    void Flush(SDL_Renderer* renderer);
+    // Drops every job without calling back; call before the renderer is
+    // destroyed.
+    void Shutdown();
+
+    void SetBudget(const Budget& budget) { budget_ = budget; }
+    const Budget& GetBudget() const { return budget_; }
+    bool IsIdle() const { return now_.empty() && prefetch_.empty(); }
+
+private:
+    UploadQueue() = default;
+    ~UploadQueue() = default;
+    UploadQueue(const UploadQueue&) = delete;
+    UploadQueue& operator=(const UploadQueue&) = delete;
+
+    struct Job {
+        uint64_t id = 0;
+        SDL_Surface* surface = nullptr;
+        SDL_Texture* texture = nullptr;
+        int nextRow = 0;
+        Callback callback;
+    };
+
+    size_t Step(SDL_Renderer* renderer, std::deque<Job>& queue, size_t byteLimit);
+    static void Release(Job& job);
+
+    std::deque<Job> now_;
+    std::deque<Job> prefetch_;
+    Budget budget_;
+    uint64_t nextId_ = 1;
+};
@@ -0,0 +1,102 @@
+#include "InputRecorder.hpp"
+#include <algorithm>
+#include <iostream>
+
+InputRecorder& InputRecorder::GetInstance() {
+    static InputRecorder instance;
+    return instance;
+}
+
+InputRecorder::~InputRecorder() {
+    Uninstall();
+}
+
+void InputRecorder::Install() {
+    if (installed_) return;
+
+    tickEvents_.reserve(512);
+    SDL_AddEventWatch(&InputRecorder::EventWatch, this);
+    installed_ = true;
+
+    const char* tracking = SDL_getenv("S2HDPP_INPUT_LATENCY");
+    if (tracking && tracking[0] == '1') {
+        SetLatencyTracking(true);
+    }
+}
+
+void InputRecorder::Uninstall() {
+    if (!installed_) return;
+
+    SDL_DelEventWatch(&InputRecorder::EventWatch, this);
+    installed_ = false;
+}
+
+int InputRecorder::EventWatch(void* userdata, SDL_Event* event) {
+    if (event->type != SDL_KEYDOWN && event->type != SDL_KEYUP) return 1;
+    if (event->key.repeat) return 1;
+
+    // Events are pushed from the thread pumping them, which is the only
+    // producer; the game thread is the only consumer.
+    TimedInput input;
+    input.timestamp = SDL_GetPerformanceCounter();
+    input.scancode = event->key.keysym.scancode;
+    input.pressed = event->type == SDL_KEYDOWN;
+    static_cast<InputRecorder*>(userdata)->queue_.Push(input);
+    return 1;
+}
+
+void InputRecorder::BeginTick() {
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // The frame built from last tick's inputs was presented before this tick
+    // started, so the gap to now bounds their input-to-present latency.
+    if (latencyTracking_ && pendingInput_ != 0) {
+        RecordLatency(now);
+    }
+
+    tickEvents_.clear();
+    TimedInput input;
+    while (queue_.Pop(input)) {
+        tickEvents_.push_back(input);
+    }
+
+    pendingInput_ = 0;
+    for (const auto& event : tickEvents_) {
+        if (event.pressed) {
+            pendingInput_ = event.timestamp;
+            break;
+        }
+    }
+}
+
+bool InputRecorder::WasPressed(SDL_Scancode scancode) const {
+    return std::any_of(tickEvents_.begin(), tickEvents_.end(), [scancode](const TimedInput& input) {
+        return input.pressed && input.scancode == scancode;
+    });
+}
+
+void InputRecorder::SetLatencyTracking(bool enabled) {
+    latencyTracking_ = enabled;
+    latencySamples_ = 0;
+    latencyTotal_ = 0.0;
+    pendingInput_ = 0;
+}
+
+void InputRecorder::RecordLatency(Uint64 now) {
+    double ms = static_cast<double>(now - pendingInput_) * 1000.0 / SDL_GetPerformanceFrequency();
+    if (latencySamples_ == 0) {
+        latencyMin_ = latencyMax_ = ms;
+    }
+    latencyMin_ = std::min(latencyMin_, ms);
+    latencyMax_ = std::max(latencyMax_, ms);
+    latencyTotal_ += ms;
+    latencySamples_++;
+
+    if (latencySamples_ >= REPORT_SAMPLES) {
+        std::cerr << "Input latency over " << latencySamples_ << " presses: avg "
+                  << latencyTotal_ / latencySamples_ << "ms, min " << latencyMin_
+                  << "ms, max " << latencyMax_ << "ms" << std::endl;
+        latencySamples_ = 0;
+        latencyTotal_ = 0.0;
+    }
+}
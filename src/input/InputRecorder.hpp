@@ -0,0 +1,54 @@
+#pragma once
+
+#include "core/SpscQueue.hpp"
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+struct TimedInput {
+    Uint64 timestamp = 0;
+    SDL_Scancode scancode = SDL_SCANCODE_UNKNOWN;
+    bool pressed = false;
+};
+
+// Records key events with performance-counter timestamps as SDL queues them,
+// before any state sees them. BeginTick hands over everything that arrived
+// since the previous tick, so presses released within one frame are not lost.
+// With latency tracking on, it also reports how long inputs took to reach a
+// presented frame.
+class InputRecorder {
+public:
+    static InputRecorder& GetInstance();
+
+    void Install();
+    void Uninstall();
+
+    void BeginTick();
+    const std::vector<TimedInput>& GetTickEvents() const { return tickEvents_; }
+    bool WasPressed(SDL_Scancode scancode) const;
+
+    void SetLatencyTracking(bool enabled);
+    bool IsLatencyTracking() const { return latencyTracking_; }
+
+    static constexpr int REPORT_SAMPLES = 30;
+
+private:
+    InputRecorder() = default;
+    ~InputRecorder();
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    static int EventWatch(void* userdata, SDL_Event* event);
+    void RecordLatency(Uint64 now);
+
+    SpscQueue<TimedInput, 512> queue_;
+    std::vector<TimedInput> tickEvents_;
+    bool installed_ = false;
+
+    bool latencyTracking_ = false;
+    Uint64 pendingInput_ = 0;
+    double latencyTotal_ = 0.0;
+    double latencyMin_ = 0.0;
+    double latencyMax_ = 0.0;
+    int latencySamples_ = 0;
+};
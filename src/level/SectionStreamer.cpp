@@ -0,0 +1,317 @@
+#include "SectionStreamer.hpp"
+#include "core/MemoryRegistry.hpp"
+#include "graphics/OverdrawMap.hpp"
+#include "graphics/UploadQueue.hpp"
+#include "resources/TextureCache.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+SectionStreamer::SectionStreamer() {
+    MemoryRegistry::GetInstance().SetBudget(MEMORY_OWNER, config_.memoryBudget);
+}
+
+void SectionStreamer::SetConfig(const Config& config) {
+    config_ = config;
+    MemoryRegistry::GetInstance().SetBudget(MEMORY_OWNER, config_.memoryBudget);
+}
+
+SectionStreamer::~SectionStreamer() {
+    Unload();
+}
+
+bool SectionStreamer::LoadAct(const std::string& actDirectory) {
+    Unload();
+
+    std::ifstream file(actDirectory + "/SECTIONS.json");
+    if (!file.is_open()) {
+        std::cerr << "Failed to open section manifest in " << actDirectory << std::endl;
+        return false;
+    }
+
+    nlohmann::json manifest = nlohmann::json::parse(file, nullptr, false);
+    if (manifest.is_discarded() || !manifest.is_object() || !manifest.contains("sections") ||
+        !manifest["sections"].is_array()) {
+        std::cerr << "Invalid section manifest in " << actDirectory << std::endl;
+        return false;
+    }
+
+    for (const char* key : {"sectionWidth", "sectionHeight"}) {
+        if (manifest.contains(key) && !manifest[key].is_number_integer()) {
+            std::cerr << "Invalid section size in " << actDirectory << std::endl;
+            return false;
+        }
+    }
+    sectionWidth_ = manifest.value("sectionWidth", 2048);
+    int sectionHeight = manifest.value("sectionHeight", 2048);
+    if (sectionWidth_ <= 0 || sectionHeight <= 0) {
+        std::cerr << "Invalid section size in " << actDirectory << std::endl;
+        return false;
+    }
+
+    int x = 0;
+    for (const auto& entry : manifest["sections"]) {
+        if (!entry.is_string()) {
+            std::cerr << "Invalid section entry " << entry.dump() << " in " << actDirectory << std::endl;
+            sections_.clear();
+            return false;
+        }
+        Section section;
+        section.path = actDirectory + "/" + entry.get<std::string>();
+        section.bounds = {x, 0, sectionWidth_, sectionHeight};
+        section.bytes = static_cast<size_t>(sectionWidth_) * sectionHeight * 4;
+        sections_.push_back(section);
+        x += sectionWidth_;
+    }
+
+    StartWorker();
+    return true;
+}
+
+void SectionStreamer::Unload() {
+    StopWorker();
+
+    for (auto& result : results_) {
+        SDL_FreeSurface(result.surface);
+    }
+    results_.clear();
+    requests_.clear();
+
+    for (auto& section : sections_) {
+        if (section.upload) {
+            UploadQueue::GetInstance().Cancel(section.upload);
+        }
+        if (section.texture) {
+            MemoryRegistry::GetInstance().Untrack(section.texture);
+            SDL_DestroyTexture(section.texture);
+        }
+    }
+    sections_.clear();
+    residentBytes_ = 0;
+    queuedBytes_ = 0;
+    direction_ = 1;
+}
+
+bool SectionStreamer::IsResident(int index) const {
+    if (index < 0 || index >= static_cast<int>(sections_.size())) return false;
+    return sections_[index].state == SectionState::Resident;
+}
+
+void SectionStreamer::Update(int cameraX) {
+    if (sections_.empty()) return;
+
+    if (cameraX > lastCameraX_) {
+        direction_ = 1;
+    } else if (cameraX < lastCameraX_) {
+        direction_ = -1;
+    }
+    lastCameraX_ = cameraX;
+
+    int first = SectionAt(cameraX);
+    int last = SectionAt(cameraX + config_.viewWidth - 1);
+    UploadFinished(first, last);
+
+    int keepMin, keepMax;
+    if (direction_ > 0) {
+        keepMin = first - config_.sectionsBehind;
+        keepMax = last + config_.sectionsAhead;
+    } else {
+        keepMin = first - config_.sectionsAhead;
+        keepMax = last + config_.sectionsBehind;
+    }
+
+    for (int i = 0; i < static_cast<int>(sections_.size()); i++) {
+        if (i < keepMin || i > keepMax) {
+            Evict(i);
+        }
+    }
+
+    // Whatever is on screen is always requested, prefetch only while it fits.
+    for (int i = first; i <= last; i++) {
+        Request(i);
+    }
+    for (int step = 1; step <= config_.sectionsAhead; step++) {
+        int index = direction_ > 0 ? last + step : first - step;
+        if (index < 0 || index >= static_cast<int>(sections_.size())) break;
+        if (sections_[index].state != SectionState::Unloaded) continue;
+        if (residentBytes_ + queuedBytes_ + sections_[index].bytes > config_.memoryBudget) break;
+        Request(index);
+    }
+
+    EnforceBudget((first + last) / 2);
+}
+
+void SectionStreamer::Render(SDL_Renderer* renderer, int cameraX, int cameraY, int viewW, int viewH) {
+    SDL_Rect view = {cameraX, cameraY, viewW, viewH};
+    for (const auto& section : sections_) {
+        if (section.state != SectionState::Resident) continue;
+        if (!SDL_HasIntersection(&section.bounds, &view)) continue;
+
+        SDL_Rect dest = {section.bounds.x - cameraX, section.bounds.y - cameraY, section.bounds.w, section.bounds.h};
+        OverdrawMap::Copy(renderer, section.texture, nullptr, &dest);
+    }
+}
+
+void SectionStreamer::StartWorker() {
+    running_ = true;
+    worker_ = std::thread(&SectionStreamer::WorkerLoop, this);
+}
+
+void SectionStreamer::StopWorker() {
+    if (!running_) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void SectionStreamer::WorkerLoop() {
+    while (true) {
+        LoadRequest request;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this]() { return !running_ || !requests_.empty(); });
+            if (!running_) return;
+            request = requests_.front();
+            requests_.pop_front();
+        }
+
+        SDL_Surface* surface = TextureCache::LoadSurface(request.path);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_.push_back({request.index, request.generation, surface});
+    }
+}
+
+void SectionStreamer::Request(int index) {
+    if (index < 0 || index >= static_cast<int>(sections_.size())) return;
+
+    Section& section = sections_[index];
+    if (section.state != SectionState::Unloaded) return;
+
+    section.state = SectionState::Queued;
+    queuedBytes_ += section.bytes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.push_back({index, section.generation, section.path});
+    }
+    wake_.notify_one();
+}
+
+void SectionStreamer::Evict(int index) {
+    Section& section = sections_[index];
+
+    if (section.state == SectionState::Queued) {
+        // A decode already in flight is dropped when its generation no longer matches.
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+            [index](const LoadRequest& request) { return request.index == index; }), requests_.end());
+        queuedBytes_ -= section.bytes;
+        if (section.upload) {
+            UploadQueue::GetInstance().Cancel(section.upload);
+            section.upload = 0;
+        }
+    } else if (section.state == SectionState::Resident) {
+        MemoryRegistry::GetInstance().Untrack(section.texture);
+        SDL_DestroyTexture(section.texture);
+        section.texture = nullptr;
+        residentBytes_ -= section.bytes;
+    } else if (section.state == SectionState::Failed) {
+        // Retried the next time it comes back into range.
+        section.state = SectionState::Unloaded;
+        return;
+    } else {
+        return;
+    }
+
+    section.generation++;
+    section.state = SectionState::Unloaded;
+}
+
+void SectionStreamer::UploadFinished(int first, int last) {
+    std::vector<LoadResult> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished.swap(results_);
+    }
+
+    for (auto& result : finished) {
+        Section& section = sections_[result.index];
+        if (section.generation != result.generation || section.state != SectionState::Queued) {
+            SDL_FreeSurface(result.surface);
+            continue;
+        }
+
+        if (!result.surface) {
+            std::cerr << "Failed to load level section: " << section.path << std::endl;
+            queuedBytes_ -= section.bytes;
+            section.state = SectionState::Failed;
+            continue;
+        }
+
+        // Sections on screen go ahead of prefetched ones in the upload queue.
+        int index = result.index;
+        unsigned int generation = result.generation;
+        UploadPriority priority = index >= first && index <= last ? UploadPriority::Now : UploadPriority::Prefetch;
+        section.upload = UploadQueue::GetInstance().Enqueue(result.surface, priority,
+            [this, index, generation](SDL_Texture* texture) { OnUploaded(index, generation, texture); });
+    }
+}
+
+void SectionStreamer::OnUploaded(int index, unsigned int generation, SDL_Texture* texture) {
+    Section& section = sections_[index];
+    section.upload = 0;
+    if (section.generation != generation || section.state != SectionState::Queued) {
+        if (texture) SDL_DestroyTexture(texture);
+        return;
+    }
+
+    queuedBytes_ -= section.bytes;
+    if (!texture) {
+        std::cerr << "Failed to create level section texture: " << section.path << std::endl;
+        section.state = SectionState::Failed;
+        return;
+    }
+
+    section.texture = texture;
+    section.bytes = MemoryRegistry::GetTextureBytes(texture);
+    residentBytes_ += section.bytes;
+    section.state = SectionState::Resident;
+    MemoryRegistry::GetInstance().Track(section.texture, ResourceKind::Texture, MEMORY_OWNER, section.path, section.bytes);
+}
+
+void SectionStreamer::EnforceBudget(int currentIndex) {
+    int first = SectionAt(lastCameraX_);
+    int last = SectionAt(lastCameraX_ + config_.viewWidth - 1);
+
+    while (residentBytes_ > config_.memoryBudget) {
+        int victim = -1;
+        int victimDistance = 0;
+        for (int i = 0; i < static_cast<int>(sections_.size()); i++) {
+            if (sections_[i].state != SectionState::Resident) continue;
+            if (i >= first && i <= last) continue;
+
+            // Sections behind the direction of travel go before those ahead of it.
+            int distance = std::abs(i - currentIndex) * 2;
+            if ((i - currentIndex) * direction_ < 0) distance++;
+            if (distance > victimDistance) {
+                victim = i;
+                victimDistance = distance;
+            }
+        }
+        if (victim < 0) break;
+        Evict(victim);
+    }
+}
+
+int SectionStreamer::SectionAt(int worldX) const {
+    if (sectionWidth_ <= 0) return 0;
+    int index = worldX / sectionWidth_;
+    return std::clamp(index, 0, static_cast<int>(sections_.size()) - 1);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Splits an act into horizontal sections and keeps only the ones around the
+// camera resident. Decoding happens on a worker thread, texture creation and
+// destruction on the render thread.
+class SectionStreamer {
+public:
+    struct Config {
+        size_t memoryBudget = 96 * 1024 * 1024;
+        int sectionsAhead = 2;
+        int sectionsBehind = 1;
+        int viewWidth = 1920;
+    };
+
+    SectionStreamer();
+    ~SectionStreamer();
+
+    bool LoadAct(const std::string& actDirectory);
+    void Unload();
+
+    void SetConfig(const Config& config);
+    const Config& GetConfig() const { return config_; }
+
+    void Update(int cameraX);
+    void Render(SDL_Renderer* renderer, int cameraX, int cameraY, int viewW, int viewH);
+
+    size_t GetResidentBytes() const { return residentBytes_; }
+    int GetSectionCount() const { return static_cast<int>(sections_.size()); }
+    bool IsResident(int index) const;
+
+    static constexpr const char* MEMORY_OWNER = "Level";
+
+private:
+    enum class SectionState {
+        Unloaded,
+        Queued,
+        Resident,
+        Failed
+    };
+
+    struct Section {
+        std::string path;
+        SDL_Rect bounds;
+        size_t bytes = 0;
+        SectionState state = SectionState::Unloaded;
+        unsigned int generation = 0;
+        SDL_Texture* texture = nullptr;
+        uint64_t upload = 0;
+    };
+
+    struct LoadRequest {
+        int index;
+        unsigned int generation;
+        std::string path;
+    };
+
+    struct LoadResult {
+        int index;
+        unsigned int generation;
+        SDL_Surface* surface;
+    };
+
+    void WorkerLoop();
+    void StartWorker();
+    void StopWorker();
+    void Request(int index);
+    void Evict(int index);
+    void UploadFinished(int first, int last);
+    void OnUploaded(int index, unsigned int generation, SDL_Texture* texture);
+    void EnforceBudget(int currentIndex);
+    int SectionAt(int worldX) const;
+
+    Config config_;
+    std::vector<Section> sections_;
+    int sectionWidth_ = 0;
+    size_t residentBytes_ = 0;
+    size_t queuedBytes_ = 0;
+    int lastCameraX_ = 0;
+    int direction_ = 1;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<LoadRequest> requests_;
+    std::vector<LoadResult> results_;
+    std::atomic<bool> running_{false};
+};
@@ -0,0 +1,258 @@
+#include "TerrainCollision.hpp"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TERRAIN_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TERRAIN_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+    bool ReadFile(const std::string& path, std::vector<uint8_t>& data) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+#if defined(TERRAIN_SIMD_SSE2)
+    using Lanes = __m128i;
+    inline Lanes LoadLanes(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline void StoreLanes(int32_t* p, Lanes v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    inline Lanes Splat(int32_t v) { return _mm_set1_epi32(v); }
+    inline Lanes Xor(Lanes a, Lanes b) { return _mm_xor_si128(a, b); }
+    inline Lanes And(Lanes a, Lanes b) { return _mm_and_si128(a, b); }
+    inline Lanes Add(Lanes a, Lanes b) { return _mm_add_epi32(a, b); }
+    inline Lanes Sub(Lanes a, Lanes b) { return _mm_sub_epi32(a, b); }
+    inline Lanes Equal(Lanes a, Lanes b) { return _mm_cmpeq_epi32(a, b); }
+    inline Lanes ShiftRight4(Lanes a) { return _mm_srai_epi32(a, 4); }
+    inline Lanes ShiftLeft4(Lanes a) { return _mm_slli_epi32(a, 4); }
+#elif defined(TERRAIN_SIMD_NEON)
+    using Lanes = int32x4_t;
+    inline Lanes LoadLanes(const int32_t* p) { return vld1q_s32(p); }
+    inline void StoreLanes(int32_t* p, Lanes v) { vst1q_s32(p, v); }
+    inline Lanes Splat(int32_t v) { return vdupq_n_s32(v); }
+    inline Lanes Xor(Lanes a, Lanes b) { return veorq_s32(a, b); }
+    inline Lanes And(Lanes a, Lanes b) { return vandq_s32(a, b); }
+    inline Lanes Add(Lanes a, Lanes b) { return vaddq_s32(a, b); }
+    inline Lanes Sub(Lanes a, Lanes b) { return vsubq_s32(a, b); }
+    inline Lanes Equal(Lanes a, Lanes b) { return vreinterpretq_s32_u32(vceqq_s32(a, b)); }
+    inline Lanes ShiftRight4(Lanes a) { return vshrq_n_s32(a, 4); }
+    inline Lanes ShiftLeft4(Lanes a) { return vshlq_n_s32(a, 4); }
+#endif
+}
+
+TerrainCollision::TerrainCollision() {}
+
+bool TerrainCollision::Load(const std::string& actDirectory) {
+    std::vector<uint8_t> heights, angles, layout;
+    if (!ReadFile(actDirectory + "/COLLISION/HEIGHTS.bin", heights) ||
+        !ReadFile(actDirectory + "/COLLISION/ANGLES.bin", angles) ||
+        !ReadFile(actDirectory + "/COLLISION/LAYOUT.bin", layout)) {
+        std::cerr << "Failed to load collision data in " << actDirectory << std::endl;
+        return false;
+    }
+
+    if (heights.size() != angles.size() * BLOCK_SIZE || layout.size() < 4) {
+        std::cerr << "Invalid collision data in " << actDirectory << std::endl;
+        return false;
+    }
+
+    int width = layout[0] | (layout[1] << 8);
+    int height = layout[2] | (layout[3] << 8);
+    if (layout.size() != 4 + static_cast<size_t>(width) * height * 2) {
+        std::cerr << "Invalid collision layout in " << actDirectory << std::endl;
+        return false;
+    }
+
+    std::vector<uint16_t> cells(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < cells.size(); i++) {
+        cells[i] = static_cast<uint16_t>(layout[4 + i * 2] | (layout[5 + i * 2] << 8));
+    }
+
+    SetBlocks(std::vector<int8_t>(heights.begin(), heights.end()), angles);
+    SetLayout(width, height, cells);
+    return true;
+}
+
+void TerrainCollision::SetBlocks(const std::vector<int8_t>& heights, const std::vector<uint8_t>& angles) {
+    size_t variants = angles.size() * 4;
+    for (auto& extents : extents_) {
+        extents.assign(variants * BLOCK_SIZE, EMPTY);
+    }
+    angles_.assign(variants, 0);
+
+    for (size_t block = 0; block < angles.size(); block++) {
+        for (int flip = 0; flip < 4; flip++) {
+            bool flipX = (flip & 1) != 0;
+            bool flipY = (flip & 2) != 0;
+
+            bool solid[BLOCK_SIZE][BLOCK_SIZE] = {};
+            for (int x = 0; x < BLOCK_SIZE; x++) {
+                int h = heights[block * BLOCK_SIZE + (flipX ? BLOCK_SIZE - 1 - x : x)];
+                for (int y = 0; y < BLOCK_SIZE; y++) {
+                    // Positive heights rise from the bottom edge, negative ones hang from the top.
+                    bool filled = h > 0 ? y >= BLOCK_SIZE - h : (h < 0 && y < -h);
+                    solid[flipY ? BLOCK_SIZE - 1 - y : y][x] = filled;
+                }
+            }
+
+            size_t variant = block * 4 + flip;
+            uint8_t* down = &extents_[static_cast<int>(SensorDirection::Down)][variant * BLOCK_SIZE];
+            uint8_t* up = &extents_[static_cast<int>(SensorDirection::Up)][variant * BLOCK_SIZE];
+            uint8_t* right = &extents_[static_cast<int>(SensorDirection::Right)][variant * BLOCK_SIZE];
+            uint8_t* left = &extents_[static_cast<int>(SensorDirection::Left)][variant * BLOCK_SIZE];
+            for (int i = 0; i < BLOCK_SIZE; i++) {
+                for (int step = BLOCK_SIZE - 1; step >= 0; step--) {
+                    if (solid[step][i]) down[i] = static_cast<uint8_t>(step);
+                    if (solid[BLOCK_SIZE - 1 - step][i]) up[i] = static_cast<uint8_t>(step);
+                    if (solid[i][step]) right[i] = static_cast<uint8_t>(step);
+                    if (solid[i][BLOCK_SIZE - 1 - step]) left[i] = static_cast<uint8_t>(step);
+                }
+            }
+
+            // Odd angles are flagged as "snap to the nearest quadrant" and never flip.
+            uint8_t angle = angles[block];
+            if (!(angle & 1)) {
+                if (flipX) angle = static_cast<uint8_t>(-angle);
+                if (flipY) angle = static_cast<uint8_t>(0x80 - angle);
+            }
+            angles_[variant] = angle;
+        }
+    }
+}
+
+void TerrainCollision::SetLayout(int width, int height, const std::vector<uint16_t>& cells) {
+    width_ = width;
+    height_ = height;
+    strideShift_ = 0;
+    while ((1 << strideShift_) < width) {
+        strideShift_++;
+    }
+
+    cells_.assign(static_cast<size_t>(height) << strideShift_, 0);
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+            uint16_t cell = cells[static_cast<size_t>(row) * width + col];
+            uint16_t variant = static_cast<uint16_t>((cell & CELL_BLOCK_MASK) * 4);
+            if (cell & CELL_FLIP_X) variant |= 1;
+            if (cell & CELL_FLIP_Y) variant |= 2;
+            if (cell & CELL_SOLID_TOP) variant |= INTERNAL_SOLID_TOP;
+            if (cell & CELL_SOLID_LRB) variant |= INTERNAL_SOLID_LRB;
+            cells_[(static_cast<size_t>(row) << strideShift_) + col] = variant;
+        }
+    }
+}
+
+SensorResult TerrainCollision::Query(SensorDirection direction, int x, int y) const {
+    int32_t px = x, py = y, distance;
+    uint8_t angle;
+    Query(direction, &px, &py, 1, &distance, &angle);
+    return {distance, angle};
+}
+
+void TerrainCollision::Query(SensorDirection direction, const int32_t* x, const int32_t* y, size_t count,
+                             int32_t* distance, uint8_t* angle) const {
+    int dir = static_cast<int>(direction);
+    bool vertical = direction == SensorDirection::Down || direction == SensorDirection::Up;
+    const int32_t* primary = vertical ? y : x;
+    const int32_t* secondary = vertical ? x : y;
+    size_t i = 0;
+
+#if defined(TERRAIN_SIMD_SSE2) || defined(TERRAIN_SIMD_NEON)
+    // Upward and leftward probes run mirrored (~a), so every direction scans towards +primary.
+    bool negative = direction == SensorDirection::Up || direction == SensorDirection::Left;
+    const Lanes invert = Splat(negative ? -1 : 0);
+    const Lanes fifteen = Splat(BLOCK_SIZE - 1);
+    const Lanes zero = Splat(0);
+    const Lanes empty = Splat(EMPTY);
+
+    int32_t tile[4], across[4], column[4], extent[4], delta[4];
+    uint8_t firstAngle[4], secondAngle[4];
+    for (; i + 4 <= count; i += 4) {
+        Lanes a = Xor(LoadLanes(primary + i), invert);
+        Lanes b = LoadLanes(secondary + i);
+        Lanes t = ShiftRight4(a);
+        Lanes offset = And(a, fifteen);
+        StoreLanes(tile, Xor(t, invert));
+        StoreLanes(across, ShiftRight4(b));
+        StoreLanes(column, And(b, fifteen));
+
+        for (int lane = 0; lane < 4; lane++) {
+            extent[lane] = Extent(dir, tile[lane], across[lane], column[lane], &firstAngle[lane]);
+        }
+
+        // Step one block forward when empty, one back when full at the entry edge.
+        Lanes e = LoadLanes(extent);
+        Lanes step = Sub(Equal(e, zero), Equal(e, empty));
+        StoreLanes(delta, step);
+        StoreLanes(tile, Xor(Add(t, step), invert));
+
+        for (int lane = 0; lane < 4; lane++) {
+            if (delta[lane] != 0) {
+                extent[lane] = Extent(dir, tile[lane], across[lane], column[lane], &secondAngle[lane]);
+            } else {
+                secondAngle[lane] = firstAngle[lane];
+            }
+        }
+
+        Lanes e2 = LoadLanes(extent);
+        StoreLanes(distance + i, Sub(Add(ShiftLeft4(step), e2), offset));
+
+        for (int lane = 0; lane < 4; lane++) {
+            angle[i + lane] = (delta[lane] < 0 && extent[lane] == EMPTY) ? firstAngle[lane] : secondAngle[lane];
+        }
+    }
+#endif
+
+    QueryScalar(dir, primary + i, secondary + i, count - i, distance + i, angle + i);
+}
+
+void TerrainCollision::QueryScalar(int direction, const int32_t* primary, const int32_t* secondary, size_t count,
+                                   int32_t* distance, uint8_t* angle) const {
+    bool negative = direction == static_cast<int>(SensorDirection::Up) || direction == static_cast<int>(SensorDirection::Left);
+    int invert = negative ? -1 : 0;
+
+    for (size_t i = 0; i < count; i++) {
+        int a = primary[i] ^ invert;
+        int t = a >> 4;
+        int offset = a & (BLOCK_SIZE - 1);
+        int across = secondary[i] >> 4;
+        int column = secondary[i] & (BLOCK_SIZE - 1);
+
+        uint8_t firstAngle, secondAngle;
+        int e = Extent(direction, t ^ invert, across, column, &firstAngle);
+        int delta = (e == EMPTY ? 1 : 0) - (e == 0 ? 1 : 0);
+        int e2 = e;
+        secondAngle = firstAngle;
+        if (delta != 0) {
+            e2 = Extent(direction, (t + delta) ^ invert, across, column, &secondAngle);
+        }
+
+        distance[i] = delta * BLOCK_SIZE + e2 - offset;
+        angle[i] = (delta < 0 && e2 == EMPTY) ? firstAngle : secondAngle;
+    }
+}
+
+uint8_t TerrainCollision::Extent(int direction, int tile, int across, int column, uint8_t* angle) const {
+    bool vertical = direction == static_cast<int>(SensorDirection::Down) || direction == static_cast<int>(SensorDirection::Up);
+    int row = vertical ? tile : across;
+    int col = vertical ? across : tile;
+
+    *angle = 0;
+    if (row < 0 || row >= height_ || col < 0 || col >= width_) return EMPTY;
+
+    uint16_t cell = cells_[(static_cast<size_t>(row) << strideShift_) + col];
+    uint16_t solid = direction == static_cast<int>(SensorDirection::Down) ? INTERNAL_SOLID_TOP : INTERNAL_SOLID_LRB;
+    if (!(cell & solid)) return EMPTY;
+
+    size_t variant = cell & VARIANT_MASK;
+    if (variant >= angles_.size()) return EMPTY;
+
+    *angle = angles_[variant];
+    return extents_[direction][variant * BLOCK_SIZE + column];
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class SensorDirection {
+    Down,
+    Up,
+    Right,
+    Left
+};
+
+struct SensorResult {
+    int distance;
+    uint8_t angle;
+};
+
+// Sonic 2 style 16x16 block collision. Block height arrays and their flipped
+// variants are baked into per-direction extent tables, so every sensor probe
+// is two table reads regardless of direction or flip.
+class TerrainCollision {
+public:
+    static constexpr int BLOCK_SIZE = 16;
+    static constexpr uint8_t EMPTY = 16;
+
+    // Layout cells use the Sonic 2 chunk mapping bits.
+    static constexpr uint16_t CELL_BLOCK_MASK = 0x03FF;
+    static constexpr uint16_t CELL_FLIP_X = 0x0400;
+    static constexpr uint16_t CELL_FLIP_Y = 0x0800;
+    static constexpr uint16_t CELL_SOLID_TOP = 0x1000;
+    static constexpr uint16_t CELL_SOLID_LRB = 0x2000;
+
+    TerrainCollision();
+
+    bool Load(const std::string& actDirectory);
+    void SetBlocks(const std::vector<int8_t>& heights, const std::vector<uint8_t>& angles);
+    void SetLayout(int width, int height, const std::vector<uint16_t>& cells);
+
+    SensorResult Query(SensorDirection direction, int x, int y) const;
+    void Query(SensorDirection direction, const int32_t* x, const int32_t* y, size_t count,
+               int32_t* distance, uint8_t* angle) const;
+
+    int GetWidth() const { return width_ * BLOCK_SIZE; }
+    int GetHeight() const { return height_ * BLOCK_SIZE; }
+
+private:
+    static constexpr uint16_t VARIANT_MASK = 0x3FFF;
+    static constexpr uint16_t INTERNAL_SOLID_TOP = 0x4000;
+    static constexpr uint16_t INTERNAL_SOLID_LRB = 0x8000;
+
+    uint8_t Extent(int direction, int tile, int across, int column, uint8_t* angle) const;
+    void QueryScalar(int direction, const int32_t* primary, const int32_t* secondary, size_t count,
+                     int32_t* distance, uint8_t* angle) const;
+
+    // One 16-byte row per block variant (block * 4 + flips) for each direction.
+    std::vector<uint8_t> extents_[4];
+    std::vector<uint8_t> angles_;
+
+    std::vector<uint16_t> cells_;
+    int width_ = 0;
+    int height_ = 0;
+    int strideShift_ = 0;
+};
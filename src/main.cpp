@@ -1,15 +1,90 @@
 #include "core/GameContext.hpp"
+#include "core/HitchDetector.hpp"
+#include "core/IdlePacer.hpp"
+#include "core/StartupPipeline.hpp"
+#include "core/StartupTrace.hpp"
+#include "core/StatePreloader.hpp"
+#include "graphics/FlashVariants.hpp"
+#include "graphics/OverdrawMap.hpp"
+#include "graphics/UploadQueue.hpp"
+#include "mods/ModIndex.hpp"
+#include "states/Title/TitleResources.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+namespace {
+    const std::string DATA_DIRECTORY = "data/SONICORCA/";
+
+    std::vector<std::string> GetFirstFramePaths() {
+        return { DATA_DIRECTORY + "DISCLAIMER.png" };
+    }
+
+    std::vector<std::string> GetEarlyStatePaths() {
+        std::vector<std::string> paths = {
+            DATA_DIRECTORY + "TEAMLOGO.png",
+            DATA_DIRECTORY + "ENGINE.png",
+            DATA_DIRECTORY + "ENGINE/PARTIAL.png",
+            DATA_DIRECTORY + "ENGINE/SONIC.png",
+            DATA_DIRECTORY + TitleResources::FONT.GetSonicOrcaPath(),
+            DATA_DIRECTORY + "FONTS/HUD/OVERLAYSILVER.png",
+            DATA_DIRECTORY + TitleResources::ANIMATION_GROUP.GetSonicOrcaPath() + ".anigroup"
+        };
+        for (const AssetId& asset : TitleResources::GetTextures()) {
+            paths.push_back(DATA_DIRECTORY + asset.GetSonicOrcaPath());
+        }
+        return paths;
+    }
+}
+
 int main(int argc, char* args[]) {
+    HitchDetector& hitches = HitchDetector::GetInstance();
+    hitches.Install();
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(args[i], "--startup-trace") == 0) {
+            StartupTrace::GetInstance().SetEnabled(true);
+        } else if (std::strcmp(args[i], "--hitch-budget") == 0 && i + 1 < argc) {
+            hitches.SetBudget(std::atof(args[++i]));
+        } else if (std::strcmp(args[i], "--no-idle-throttle") == 0) {
+            IdlePacer::GetInstance().SetEnabled(false);
+        }
+    }
+
     GameContext game;
-    
-    if (!game.Initialize()) {
+
+    // Asset reads overlap SDL and window setup; the disclaimer gets its own
+    // task so the first frame never waits behind later states' files.
+    StartupPipeline startup;
+    // Set before the scan is queued, so a Resolve that runs first waits for it.
+    ModIndex::GetInstance().BeginLoad();
+    startup.AddBackground("Prefetch first frame", []() {
+        StartupPipeline::PrefetchFiles(GetFirstFramePaths());
+    });
+    startup.AddBackground("Scan mods", []() {
+        ModIndex::GetInstance().Load();
+    });
+    startup.AddBackground("Prefetch early states", []() {
+        StartupPipeline::PrefetchFiles(GetEarlyStatePaths());
+    });
+    startup.AddMain("GameContext::Initialize", [&game]() {
+        return game.Initialize();
+    });
+
+    if (!startup.Run()) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return -1;
     }
-    
+
     game.Run();
-    
+    // Quitting from the title can leave preloaded gameplay untaken. It and
+    // the graphics singletons hold SDL objects, so they go before
+    // GameContext destroys the renderer and shuts SDL down.
+    StatePreloader::ReleaseHanded();
+    UploadQueue::GetInstance().Shutdown();
+    FlashVariants::GetInstance().Shutdown();
+    OverdrawMap::GetInstance().Shutdown();
+    hitches.Report();
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,283 @@
+#include "ModIndex.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+    int64_t GetModifiedTime(const fs::path& path) {
+        std::error_code error;
+        auto time = fs::last_write_time(path, error);
+        return error ? -1 : static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    void WriteString(std::ofstream& file, const std::string& value) {
+        uint32_t length = static_cast<uint32_t>(value.size());
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write(value.data(), length);
+    }
+
+    bool ReadString(std::ifstream& file, std::string& value) {
+        uint32_t length = 0;
+        if (!file.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > 4096) return false;
+        value.resize(length);
+        return static_cast<bool>(file.read(&value[0], length));
+    }
+
+    template <typename T>
+    void WriteValue(std::ofstream& file, T value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+}
+
+ModIndex& ModIndex::GetInstance() {
+    static ModIndex instance;
+    return instance;
+}
+
+void ModIndex::BeginLoad() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loading_ = true;
+}
+
+bool ModIndex::Load(const std::string& modsDirectory) {
+    BeginLoad();
+
+    bool loaded = ReadManifest(modsDirectory);
+    if (!loaded) {
+        std::vector<std::string> directories;
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator(modsDirectory, error)) {
+            if (entry.is_directory(error)) {
+                directories.push_back(entry.path().generic_string());
+            }
+        }
+        std::sort(directories.begin(), directories.end());
+
+        // Each worker takes the next unscanned mod; walking data/ trees is the
+        // slow part and mods are independent of each other.
+        std::vector<ScanResult> results(directories.size());
+        std::atomic<size_t> next{0};
+        unsigned int workerCount = std::max(1u, std::min<unsigned int>(std::thread::hardware_concurrency(),
+                                                                        static_cast<unsigned int>(directories.size())));
+        std::vector<std::thread> workers;
+        for (unsigned int i = 0; i < workerCount; i++) {
+            workers.emplace_back([&]() {
+                for (size_t index = next++; index < directories.size(); index = next++) {
+                    results[index] = ScanMod(directories[index]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        std::vector<Mod> mods;
+        std::vector<Stamp> stamps = {{modsDirectory, GetModifiedTime(modsDirectory)}};
+        std::unordered_map<uint64_t, int> overrides;
+        std::vector<size_t> order;
+        for (size_t i = 0; i < results.size(); i++) {
+            stamps.insert(stamps.end(), results[i].stamps.begin(), results[i].stamps.end());
+            if (results[i].valid) order.push_back(i);
+        }
+
+        // Higher priority wins; ties go to the folder that sorts first.
+        std::stable_sort(order.begin(), order.end(), [&results](size_t a, size_t b) {
+            return results[a].mod.priority > results[b].mod.priority;
+        });
+        for (size_t i : order) {
+            int modIndex = static_cast<int>(mods.size());
+            mods.push_back(results[i].mod);
+            if (!results[i].mod.enabled) continue;
+            for (const auto& file : results[i].files) {
+                uint64_t id = AssetId::Hash(file);
+                AssetId::RegisterName(id, file);
+                overrides.emplace(id, modIndex);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            mods_ = std::move(mods);
+            stamps_ = std::move(stamps);
+            overrides_ = std::move(overrides);
+        }
+        WriteManifest(modsDirectory);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loading_ = false;
+    }
+    loaded_.notify_all();
+    return true;
+}
+
+std::string ModIndex::Resolve(const std::string& dataPath) {
+    return Resolve(dataPath, AssetId::Hash(dataPath));
+}
+
+std::string ModIndex::Resolve(const AssetId& dataPath) {
+    return Resolve(dataPath.GetPath(), dataPath.GetValue());
+}
+
+std::string ModIndex::Resolve(std::string_view dataPath, uint64_t id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    loaded_.wait(lock, [this]() { return !loading_; });
+
+    auto found = overrides_.find(id);
+    if (found == overrides_.end()) {
+        return "data/" + std::string(dataPath);
+    }
+    return mods_[found->second].directory + "/data/" + std::string(dataPath);
+}
+
+std::vector<ModIndex::Mod> ModIndex::GetMods() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    loaded_.wait(lock, [this]() { return !loading_; });
+    return mods_;
+}
+
+ModIndex::ScanResult ModIndex::ScanMod(const std::string& directory) {
+    ScanResult result;
+    result.mod.directory = directory;
+    result.stamps.push_back({directory, GetModifiedTime(directory)});
+
+    std::string manifestPath = directory + "/mod.json";
+    result.stamps.push_back({manifestPath, GetModifiedTime(manifestPath)});
+
+    std::ifstream file(manifestPath);
+    if (!file.is_open()) return result;
+
+    nlohmann::json manifest = nlohmann::json::parse(file, nullptr, false);
+    if (manifest.is_discarded() || !manifest.is_object()) {
+        std::cerr << "Invalid mod manifest: " << manifestPath << std::endl;
+        return result;
+    }
+
+    // value() throws on a mistyped field, and this runs on a worker thread.
+    if ((manifest.contains("name") && !manifest["name"].is_string()) ||
+        (manifest.contains("priority") && !manifest["priority"].is_number_integer()) ||
+        (manifest.contains("enabled") && !manifest["enabled"].is_boolean())) {
+        std::cerr << "Invalid mod manifest: " << manifestPath << std::endl;
+        return result;
+    }
+
+    result.mod.name = manifest.value("name", fs::path(directory).filename().string());
+    result.mod.priority = manifest.value("priority", 0);
+    result.mod.enabled = manifest.value("enabled", true);
+    result.valid = true;
+
+    // Directory mtimes change when entries are added or removed, so stamping
+    // every folder in the tree is enough to notice new or deleted files.
+    fs::path dataDirectory = fs::path(directory) / "data";
+    std::error_code error;
+    if (!fs::is_directory(dataDirectory, error)) return result;
+
+    result.stamps.push_back({dataDirectory.generic_string(), GetModifiedTime(dataDirectory)});
+    for (fs::recursive_directory_iterator it(dataDirectory, error), end; it != end; it.increment(error)) {
+        if (error) break;
+        if (it->is_directory(error)) {
+            result.stamps.push_back({it->path().generic_string(), GetModifiedTime(it->path())});
+        } else if (it->is_regular_file(error)) {
+            result.files.push_back(it->path().lexically_relative(dataDirectory).generic_string());
+        }
+    }
+    return result;
+}
+
+bool ModIndex::ReadManifest(const std::string& modsDirectory) {
+    std::ifstream file(MANIFEST_PATH, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    uint32_t magic = 0, version = 0, count = 0;
+    std::string directory;
+    if (!ReadValue(file, magic) || !ReadValue(file, version) || magic != MAGIC || version != VERSION) return false;
+    if (!ReadString(file, directory) || directory != modsDirectory) return false;
+
+    std::vector<Stamp> stamps;
+    if (!ReadValue(file, count)) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        Stamp stamp;
+        if (!ReadString(file, stamp.path) || !ReadValue(file, stamp.time)) return false;
+        if (GetModifiedTime(stamp.path) != stamp.time) return false;
+        stamps.push_back(std::move(stamp));
+    }
+
+    std::vector<Mod> mods;
+    if (!ReadValue(file, count)) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        Mod mod;
+        uint8_t enabled = 0;
+        if (!ReadString(file, mod.directory) || !ReadString(file, mod.name) ||
+            !ReadValue(file, mod.priority) || !ReadValue(file, enabled)) {
+            return false;
+        }
+        mod.enabled = enabled != 0;
+        mods.push_back(std::move(mod));
+    }
+
+    std::unordered_map<uint64_t, int> overrides;
+    if (!ReadValue(file, count)) return false;
+    overrides.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t id = 0;
+        int32_t modIndex = 0;
+        if (!ReadValue(file, id) || !ReadValue(file, modIndex)) return false;
+        if (modIndex < 0 || modIndex >= static_cast<int32_t>(mods.size())) return false;
+        overrides.emplace(id, modIndex);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    mods_ = std::move(mods);
+    stamps_ = std::move(stamps);
+    overrides_ = std::move(overrides);
+    return true;
+}
+
+void ModIndex::WriteManifest(const std::string& modsDirectory) const {
+    std::error_code error;
+    fs::create_directories(fs::path(MANIFEST_PATH).parent_path(), error);
+
+    std::string temporaryPath = std::string(MANIFEST_PATH) + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary);
+        if (!file.is_open()) return;
+
+        WriteValue(file, MAGIC);
+        WriteValue(file, VERSION);
+        WriteString(file, modsDirectory);
+
+        WriteValue(file, static_cast<uint32_t>(stamps_.size()));
+        for (const auto& stamp : stamps_) {
+            WriteString(file, stamp.path);
+            WriteValue(file, stamp.time);
+        }
+
+        WriteValue(file, static_cast<uint32_t>(mods_.size()));
+        for (const auto& mod : mods_) {
+            WriteString(file, mod.directory);
+            WriteString(file, mod.name);
+            WriteValue(file, static_cast<int32_t>(mod.priority));
+            WriteValue(file, static_cast<uint8_t>(mod.enabled));
+        }
+
+        WriteValue(file, static_cast<uint32_t>(overrides_.size()));
+        for (const auto& entry : overrides_) {
+            WriteValue(file, entry.first);
+            WriteValue(file, static_cast<int32_t>(entry.second));
+        }
+    }
+
+    fs::rename(temporaryPath, MANIFEST_PATH, error);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "resources/AssetId.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Game-side index of installed mods and the data files each one overrides.
+// Mods are scanned in parallel, one per worker, and the merged result is
+// written to a binary manifest that later runs reuse as long as none of the
+// recorded folder or mod.json mtimes changed.
+class ModIndex {
+public:
+    struct Mod {
+        std::string directory;
+        std::string name;
+        int priority = 0;
+        bool enabled = false;
+    };
+
+    static ModIndex& GetInstance();
+
+    // Marks a load as pending so Resolve waits for it. Call on the thread
+    // that queues Load before handing Load to another thread.
+    void BeginLoad();
+    bool Load(const std::string& modsDirectory = MODS_DIRECTORY);
+
+    // Maps a path under data/ (e.g. "SONICORCA/TEAMLOGO.png") to the file that
+    // should be read, waiting for a scan that is still running.
+    std::string Resolve(const std::string& dataPath);
+    std::string Resolve(const AssetId& dataPath);
+    std::vector<Mod> GetMods();
+
+    static constexpr const char* MODS_DIRECTORY = "mods";
+    static constexpr const char* MANIFEST_PATH = "cache/mods.bin";
+    static constexpr uint32_t MAGIC = 0x4D4D3253;  // "S2MM"
+    static constexpr uint32_t VERSION = 2;
+
+private:
+    ModIndex() = default;
+    ModIndex(const ModIndex&) = delete;
+    ModIndex& operator=(const ModIndex&) = delete;
+
+    struct Stamp {
+        std::string path;
+        int64_t time = 0;
+    };
+
+    struct ScanResult {
+        Mod mod;
+        std::vector<std::string> files;
+        std::vector<Stamp> stamps;
+        bool valid = false;
+    };
+
+    static ScanResult ScanMod(const std::string& directory);
+    bool ReadManifest(const std::string& modsDirectory);
+    void WriteManifest(const std::string& modsDirectory) const;
+    std::string Resolve(std::string_view dataPath, uint64_t id);
+
+    std::vector<Mod> mods_;
+    std::vector<Stamp> stamps_;
+    // Keyed by AssetId value; the paths are only needed once a file matches.
+    std::unordered_map<uint64_t, int> overrides_;
+
+    std::mutex mutex_;
+    std::condition_variable loaded_;
+    bool loading_ = false;
+};
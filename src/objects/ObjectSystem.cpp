@@ -0,0 +1,200 @@
+#include "ObjectSystem.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+
+namespace {
+    constexpr int32_t SUBPIXELS = 256;
+
+    void UpdateBuzzer(ObjectSpan& span, int) {
+        for (size_t i = 0; i < span.count; i++) {
+            if (span.state[i] == ObjectSystem::STATE_DESTROYED) continue;
+            if (span.vx[i] == 0) span.vx[i] = -SUBPIXELS;
+
+            span.x[i] += span.vx[i];
+            int32_t travelled = span.x[i] - span.spawnX[i];
+            if (travelled <= -256 * SUBPIXELS || travelled >= 0) {
+                span.vx[i] = -span.vx[i];
+            }
+        }
+    }
+
+    void UpdateMasher(ObjectSpan& span, int frame) {
+        for (size_t i = 0; i < span.count; i++) {
+            if (span.state[i] == ObjectSystem::STATE_DESTROYED) continue;
+
+            span.vy[i] += 0x18;
+            span.y[i] += span.vy[i];
+            if (span.y[i] >= span.spawnY[i]) {
+                span.y[i] = span.spawnY[i];
+                span.vy[i] = -0x500 - ((frame & 1) ? 0x200 : 0);
+            }
+        }
+    }
+
+    bool TypeFromId(uint8_t id, ObjectType& type) {
+        switch (id) {
+            case 0x25: type = ObjectType::Ring; return true;
+            case 0x26: type = ObjectType::Monitor; return true;
+            case 0x41: type = ObjectType::Spring; return true;
+            case 0x4B: type = ObjectType::Buzzer; return true;
+            case 0x5C: type = ObjectType::Masher; return true;
+            default: return false;
+        }
+    }
+}
+
+ObjectSystem::ObjectSystem() {
+    RegisterUpdate(ObjectType::Buzzer, UpdateBuzzer);
+    RegisterUpdate(ObjectType::Masher, UpdateMasher);
+}
+
+bool ObjectSystem::LoadLayout(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open object layout: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() % 6 != 0) {
+        std::cerr << "Invalid object layout: " << path << std::endl;
+        return false;
+    }
+
+    Clear();
+
+    // Sonic 2 layout entries: x word, flags/y word, object id, subtype.
+    for (size_t offset = 0; offset < data.size(); offset += 6) {
+        int x = (data[offset] << 8) | data[offset + 1];
+        int y = ((data[offset + 2] << 8) | data[offset + 3]) & 0x0FFF;
+        if (x == 0xFFFF) break;
+
+        ObjectType type;
+        if (TypeFromId(data[offset + 4], type)) {
+            AddPlacement(type, x, y, data[offset + 5]);
+        }
+    }
+
+    Finalize();
+    return true;
+}
+
+void ObjectSystem::AddPlacement(ObjectType type, int x, int y, uint8_t subtype) {
+    Pool& pool = pools_[static_cast<size_t>(type)];
+    pool.spawnX.push_back(x * SUBPIXELS);
+    pool.spawnY.push_back(y * SUBPIXELS);
+    pool.subtype.push_back(subtype);
+    pool.x.push_back(x * SUBPIXELS);
+    pool.y.push_back(y * SUBPIXELS);
+    pool.vx.push_back(0);
+    pool.vy.push_back(0);
+    pool.state.push_back(0);
+}
+
+void ObjectSystem::Finalize() {
+    for (auto& pool : pools_) {
+        Sort(pool);
+        pool.activeBegin = 0;
+        pool.activeEnd = 0;
+    }
+}
+
+void ObjectSystem::Clear() {
+    for (auto& pool : pools_) {
+        ObjectUpdateFn update = pool.update;
+        pool = Pool();
+        pool.update = update;
+    }
+    frame_ = 0;
+}
+
+void ObjectSystem::RegisterUpdate(ObjectType type, ObjectUpdateFn update) {
+    pools_[static_cast<size_t>(type)].update = update;
+}
+
+void ObjectSystem::Update(int cameraX, int viewWidth) {
+    int32_t left = (cameraX - ACTIVATION_MARGIN) * SUBPIXELS;
+    int32_t right = (cameraX + viewWidth + ACTIVATION_MARGIN) * SUBPIXELS;
+
+    for (auto& pool : pools_) {
+        size_t begin = std::lower_bound(pool.spawnX.begin(), pool.spawnX.end(), left) - pool.spawnX.begin();
+        size_t end = std::upper_bound(pool.spawnX.begin(), pool.spawnX.end(), right) - pool.spawnX.begin();
+
+        // Objects that scrolled out of the window go back to their placement.
+        for (size_t i = pool.activeBegin; i < pool.activeEnd; i++) {
+            if (i < begin || i >= end) {
+                Respawn(pool, i);
+            }
+        }
+        pool.activeBegin = begin;
+        pool.activeEnd = end;
+
+        if (pool.update && begin < end) {
+            ObjectSpan span = GetActive(static_cast<ObjectType>(&pool - pools_.data()));
+            pool.update(span, frame_);
+        }
+    }
+
+    frame_++;
+}
+
+ObjectSpan ObjectSystem::GetActive(ObjectType type) {
+    Pool& pool = pools_[static_cast<size_t>(type)];
+    size_t begin = pool.activeBegin;
+    return {
+        pool.x.data() + begin,
+        pool.y.data() + begin,
+        pool.vx.data() + begin,
+        pool.vy.data() + begin,
+        pool.state.data() + begin,
+        pool.subtype.data() + begin,
+        pool.spawnX.data() + begin,
+        pool.spawnY.data() + begin,
+        pool.activeEnd - begin
+    };
+}
+
+size_t ObjectSystem::GetActiveCount() const {
+    size_t count = 0;
+    for (const auto& pool : pools_) {
+        count += pool.activeEnd - pool.activeBegin;
+    }
+    return count;
+}
+
+void ObjectSystem::Respawn(Pool& pool, size_t index) {
+    pool.x[index] = pool.spawnX[index];
+    pool.y[index] = pool.spawnY[index];
+    pool.vx[index] = 0;
+    pool.vy[index] = 0;
+    if (pool.state[index] != STATE_DESTROYED) {
+        pool.state[index] = 0;
+    }
+}
+
+void ObjectSystem::Sort(Pool& pool) {
+    std::vector<size_t> order(pool.spawnX.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&pool](size_t a, size_t b) {
+        return pool.spawnX[a] < pool.spawnX[b];
+    });
+
+    auto permute = [&order](auto& values) {
+        auto sorted = values;
+        for (size_t i = 0; i < order.size(); i++) {
+            sorted[i] = values[order[i]];
+        }
+        values.swap(sorted);
+    };
+    permute(pool.x);
+    permute(pool.y);
+    permute(pool.vx);
+    permute(pool.vy);
+    permute(pool.state);
+    permute(pool.subtype);
+    permute(pool.spawnX);
+    permute(pool.spawnY);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class ObjectType : uint8_t {
+    Ring,
+    Monitor,
+    Spring,
+    Buzzer,
+    Masher,
+    Count
+};
+
+// Contiguous view over the active objects of one type. Positions and
+// velocities are in 1/256 pixel units.
+struct ObjectSpan {
+    int32_t* x;
+    int32_t* y;
+    int32_t* vx;
+    int32_t* vy;
+    uint8_t* state;
+    const uint8_t* subtype;
+    const int32_t* spawnX;
+    const int32_t* spawnY;
+    size_t count;
+};
+
+using ObjectUpdateFn = void (*)(ObjectSpan& span, int frame);
+
+// Placed level objects stored per type as struct-of-arrays, each pool sorted by
+// spawn X so the camera's activation window is a contiguous range.
+class ObjectSystem {
+public:
+    static constexpr int ACTIVATION_MARGIN = 320;
+    static constexpr uint8_t STATE_DESTROYED = 0xFF;
+
+    ObjectSystem();
+
+    bool LoadLayout(const std::string& path);
+    void AddPlacement(ObjectType type, int x, int y, uint8_t subtype);
+    void Finalize();
+    void Clear();
+
+    void RegisterUpdate(ObjectType type, ObjectUpdateFn update);
+    void Update(int cameraX, int viewWidth);
+
+    ObjectSpan GetActive(ObjectType type);
+    size_t GetActiveCount() const;
+
+private:
+    struct Pool {
+        std::vector<int32_t> x;
+        std::vector<int32_t> y;
+        std::vector<int32_t> vx;
+        std::vector<int32_t> vy;
+        std::vector<uint8_t> state;
+        std::vector<uint8_t> subtype;
+        std::vector<int32_t> spawnX;
+        std::vector<int32_t> spawnY;
+        size_t activeBegin = 0;
+        size_t activeEnd = 0;
+        ObjectUpdateFn update = nullptr;
+    };
+
+    static void Respawn(Pool& pool, size_t index);
+    static void Sort(Pool& pool);
+
+    std::array<Pool, static_cast<size_t>(ObjectType::Count)> pools_;
+    int frame_ = 0;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Sonic 2 style fixed point. Positions and speeds are in 1/256 pixel units,
+// angles are bytes where 0x40 is a quarter turn (clockwise on screen).
+// The tables are generated at compile time from fixed-length series, so the
+// values do not depend on the target's libm.
+namespace FixedMath {
+    constexpr int32_t ONE = 256;
+    constexpr double PI = 3.14159265358979323846;
+
+    constexpr int32_t Mul(int32_t a, int32_t b) {
+        return static_cast<int32_t>((static_cast<int64_t>(a) * b) >> 8);
+    }
+
+    constexpr int32_t ToPixels(int32_t value) {
+        return value >> 8;
+    }
+
+    constexpr int32_t FromPixels(int32_t pixels) {
+        return pixels * ONE;
+    }
+
+    namespace detail {
+        constexpr double Round(double value) {
+            return value >= 0.0 ? static_cast<double>(static_cast<int64_t>(value + 0.5))
+                                : -static_cast<double>(static_cast<int64_t>(-value + 0.5));
+        }
+
+        constexpr double SinSeries(double x) {
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 12; n++) {
+                term *= -x * x / ((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr double AtanSeries(double x) {
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 40; n++) {
+                term *= -x * x;
+                sum += term / (2 * n + 1);
+            }
+            return sum;
+        }
+
+        // Quarter-wave symmetry keeps the series argument within [0, pi/2].
+        constexpr std::array<int16_t, 320> MakeSineTable() {
+            std::array<int16_t, 320> table{};
+            for (int i = 0; i < 320; i++) {
+                int angle = i & 0xFF;
+                int quarter = angle & 0x3F;
+                int quadrant = angle >> 6;
+                int step = (quadrant & 1) ? 0x40 - quarter : quarter;
+                double value = Round(SinSeries(step * PI / 128.0) * ONE);
+                table[i] = static_cast<int16_t>(quadrant >= 2 ? -value : value);
+            }
+            return table;
+        }
+
+        // atan(i / 256) in byte angles for i in [0, 256], i.e. 0x00 to 0x20.
+        constexpr std::array<uint8_t, 257> MakeAtanTable() {
+            std::array<uint8_t, 257> table{};
+            for (int i = 0; i <= 256; i++) {
+                double ratio = i / 256.0;
+                double radians = ratio <= 0.41421356237309503
+                    ? AtanSeries(ratio)
+                    : PI / 4.0 + AtanSeries((ratio - 1.0) / (ratio + 1.0));
+                table[i] = static_cast<uint8_t>(Round(radians * 128.0 / PI));
+            }
+            return table;
+        }
+    }
+
+    constexpr std::array<int16_t, 320> SINE_TABLE = detail::MakeSineTable();
+    constexpr std::array<uint8_t, 257> ATAN_TABLE = detail::MakeAtanTable();
+
+    static_assert(SINE_TABLE[0x00] == 0 && SINE_TABLE[0x40] == 256 && SINE_TABLE[0x80] == 0, "sine table");
+    static_assert(SINE_TABLE[0x20] == 181 && SINE_TABLE[0xC0] == -256, "sine table");
+    static_assert(ATAN_TABLE[0] == 0 && ATAN_TABLE[256] == 0x20, "atan table");
+
+    constexpr int32_t Sin(uint8_t angle) {
+        return SINE_TABLE[angle];
+    }
+
+    constexpr int32_t Cos(uint8_t angle) {
+        return SINE_TABLE[angle + 0x40];
+    }
+
+    // Byte angle of the vector (x, y), screen coordinates.
+    constexpr uint8_t Atan2(int32_t x, int32_t y) {
+        if (x == 0 && y == 0) return 0x40;
+
+        int64_t ax = x < 0 ? -static_cast<int64_t>(x) : x;
+        int64_t ay = y < 0 ? -static_cast<int64_t>(y) : y;
+        int angle = ay < ax ? ATAN_TABLE[(ay << 8) / ax]
+                            : 0x40 - ATAN_TABLE[(ax << 8) / ay];
+
+        if (x < 0) angle = 0x80 - angle;
+        if (y < 0) angle = 0x100 - angle;
+        return static_cast<uint8_t>(angle);
+    }
+}
@@ -0,0 +1,315 @@
+#include "Player.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace FixedMath;
+
+namespace {
+    uint8_t FloorMode(uint8_t angle) {
+        return static_cast<uint8_t>((angle + 0x20) & 0xC0);
+    }
+}
+
+Player::Player(const TerrainCollision* terrain)
+    : terrain_(terrain)
+{
+}
+
+void Player::Reset(int x, int y) {
+    x_ = FromPixels(x);
+    y_ = FromPixels(y);
+    xSpeed_ = 0;
+    ySpeed_ = 0;
+    groundSpeed_ = 0;
+    angle_ = 0;
+    grounded_ = false;
+    rolling_ = false;
+    jumping_ = false;
+    jumpHeld_ = false;
+}
+
+void Player::Update(const PlayerInput& input) {
+    if (!terrain_) return;
+
+    if (!grounded_) {
+        UpdateAir(input);
+    } else if (rolling_) {
+        UpdateRolling(input);
+    } else {
+        UpdateGround(input);
+    }
+
+    jumpHeld_ = input.jump;
+}
+
+void Player::UpdateGround(const PlayerInput& input) {
+    if (input.jump && !jumpHeld_) {
+        Jump();
+        return;
+    }
+
+    ApplySlope(SLOPE_FACTOR);
+
+    if (input.left) {
+        if (groundSpeed_ > 0) {
+            groundSpeed_ -= DECELERATION;
+            if (groundSpeed_ <= 0) groundSpeed_ = -0x80;
+        } else if (groundSpeed_ > -TOP_SPEED) {
+            groundSpeed_ = std::max(groundSpeed_ - ACCELERATION, -TOP_SPEED);
+        }
+    } else if (input.right) {
+        if (groundSpeed_ < 0) {
+            groundSpeed_ += DECELERATION;
+            if (groundSpeed_ >= 0) groundSpeed_ = 0x80;
+        } else if (groundSpeed_ < TOP_SPEED) {
+            groundSpeed_ = std::min(groundSpeed_ + ACCELERATION, TOP_SPEED);
+        }
+    } else if (groundSpeed_ > 0) {
+        groundSpeed_ = std::max(groundSpeed_ - FRICTION, 0);
+    } else if (groundSpeed_ < 0) {
+        groundSpeed_ = std::min(groundSpeed_ + FRICTION, 0);
+    }
+
+    if (input.down && std::abs(groundSpeed_) >= ROLL_MIN_SPEED) {
+        rolling_ = true;
+        y_ += FromPixels(HEIGHT_RADIUS - ROLL_HEIGHT_RADIUS);
+    }
+
+    ApplyGroundVelocity();
+    CheckWalls();
+    x_ += xSpeed_;
+    y_ += ySpeed_;
+    FollowFloor();
+}
+
+void Player::UpdateRolling(const PlayerInput& input) {
+    if (input.jump && !jumpHeld_) {
+        Jump();
+        return;
+    }
+
+    ApplySlope(ROLL_SLOPE_FACTOR);
+
+    if (input.left && groundSpeed_ > 0) {
+        groundSpeed_ = std::max(groundSpeed_ - ROLL_DECELERATION, 0);
+    } else if (input.right && groundSpeed_ < 0) {
+        groundSpeed_ = std::min(groundSpeed_ + ROLL_DECELERATION, 0);
+    }
+
+    if (groundSpeed_ > 0) {
+        groundSpeed_ = std::max(groundSpeed_ - ROLL_FRICTION, 0);
+    } else if (groundSpeed_ < 0) {
+        groundSpeed_ = std::min(groundSpeed_ + ROLL_FRICTION, 0);
+    }
+
+    if (groundSpeed_ == 0) {
+        rolling_ = false;
+        y_ -= FromPixels(HEIGHT_RADIUS - ROLL_HEIGHT_RADIUS);
+    }
+
+    ApplyGroundVelocity();
+    xSpeed_ = std::clamp(xSpeed_, -ROLL_TOP_SPEED, ROLL_TOP_SPEED);
+    CheckWalls();
+    x_ += xSpeed_;
+    y_ += ySpeed_;
+    FollowFloor();
+}
+
+void Player::UpdateAir(const PlayerInput& input) {
+    if (jumping_ && !input.jump && ySpeed_ < -JUMP_RELEASE_SPEED) {
+        ySpeed_ = -JUMP_RELEASE_SPEED;
+    }
+
+    if (input.left && xSpeed_ > -TOP_SPEED) {
+        xSpeed_ = std::max(xSpeed_ - AIR_ACCELERATION, -TOP_SPEED);
+    } else if (input.right && xSpeed_ < TOP_SPEED) {
+        xSpeed_ = std::min(xSpeed_ + AIR_ACCELERATION, TOP_SPEED);
+    }
+
+    // Air drag near the top of a jump.
+    if (ySpeed_ < 0 && ySpeed_ > -JUMP_RELEASE_SPEED) {
+        xSpeed_ -= xSpeed_ >> 5;
+    }
+
+    CheckWalls();
+    x_ += xSpeed_;
+    y_ += ySpeed_;
+    ySpeed_ = std::min(ySpeed_ + GRAVITY, MAX_FALL_SPEED);
+
+    // The angle rotates back to upright while airborne.
+    if (angle_ != 0) {
+        if (angle_ < 0x80) {
+            angle_ = angle_ > 2 ? static_cast<uint8_t>(angle_ - 2) : 0;
+        } else {
+            angle_ = angle_ < 0xFE ? static_cast<uint8_t>(angle_ + 2) : 0;
+        }
+    }
+
+    if (ySpeed_ < 0) {
+        CheckCeiling();
+    } else {
+        CheckLanding();
+    }
+}
+
+void Player::ApplySlope(int32_t factor) {
+    // No slope force on ceilings.
+    if (static_cast<uint8_t>(angle_ + 0x60) >= 0xC0) return;
+
+    int32_t force = Mul(Sin(angle_), factor);
+    if (rolling_ && (groundSpeed_ >= 0) != (force >= 0)) {
+        force >>= 2;
+    }
+    if (groundSpeed_ != 0 || rolling_) {
+        groundSpeed_ += force;
+    }
+}
+
+void Player::Jump() {
+    uint8_t angle = static_cast<uint8_t>(angle_ - 0x40);
+    xSpeed_ += Mul(JUMP_SPEED, Cos(angle));
+    ySpeed_ += Mul(JUMP_SPEED, Sin(angle));
+    grounded_ = false;
+    jumping_ = true;
+    if (!rolling_) {
+        rolling_ = true;
+        y_ += FromPixels(HEIGHT_RADIUS - ROLL_HEIGHT_RADIUS);
+    }
+}
+
+void Player::ApplyGroundVelocity() {
+    xSpeed_ = Mul(groundSpeed_, Cos(angle_));
+    ySpeed_ = Mul(groundSpeed_, Sin(angle_));
+}
+
+void Player::CheckWalls() {
+    if (xSpeed_ == 0) return;
+    if (grounded_ && FloorMode(angle_) != 0) return;
+
+    bool right = xSpeed_ > 0;
+    int probeY = GetY() + ((grounded_ && angle_ == 0) ? 8 : 0);
+    SensorResult hit = terrain_->Query(right ? SensorDirection::Right : SensorDirection::Left, GetX(), probeY);
+
+    int32_t room = FromPixels(hit.distance - PUSH_RADIUS);
+    int32_t step = right ? xSpeed_ : -xSpeed_;
+    if (room < step) {
+        xSpeed_ = right ? room : -room;
+        if (grounded_) groundSpeed_ = 0;
+    }
+}
+
+void Player::FollowFloor() {
+    int px = GetX();
+    int py = GetY();
+    int h = HeightRadius();
+    int w = WIDTH_RADIUS;
+
+    uint8_t mode = FloorMode(angle_);
+    SensorDirection direction;
+    int32_t sx[2], sy[2];
+    switch (mode) {
+        case 0x00:
+            direction = SensorDirection::Down;
+            sx[0] = px - w; sy[0] = py + h;
+            sx[1] = px + w; sy[1] = py + h;
+            break;
+        case 0x40:
+            direction = SensorDirection::Left;
+            sx[0] = px - h; sy[0] = py + w;
+            sx[1] = px - h; sy[1] = py - w;
+            break;
+        case 0x80:
+            direction = SensorDirection::Up;
+            sx[0] = px + w; sy[0] = py - h;
+            sx[1] = px - w; sy[1] = py - h;
+            break;
+        default:
+            direction = SensorDirection::Right;
+            sx[0] = px + h; sy[0] = py - w;
+            sx[1] = px + h; sy[1] = py + w;
+            break;
+    }
+
+    int32_t distance[2];
+    uint8_t angle[2];
+    terrain_->Query(direction, sx, sy, 2, distance, angle);
+    int nearest = distance[0] <= distance[1] ? 0 : 1;
+    int d = distance[nearest];
+
+    int tolerance = std::min(std::abs(ToPixels(groundSpeed_)) + 4, SNAP_DISTANCE);
+    if (d > tolerance) {
+        grounded_ = false;
+        jumping_ = false;
+        return;
+    }
+    if (d < -SNAP_DISTANCE) return;
+
+    switch (direction) {
+        case SensorDirection::Down: y_ += FromPixels(d); break;
+        case SensorDirection::Up: y_ -= FromPixels(d); break;
+        case SensorDirection::Right: x_ += FromPixels(d); break;
+        case SensorDirection::Left: x_ -= FromPixels(d); break;
+    }
+
+    // Flagged (odd) angles snap to the current quadrant.
+    angle_ = (angle[nearest] & 1) ? mode : angle[nearest];
+
+    if (FloorMode(angle_) != 0 && std::abs(groundSpeed_) < SLIP_SPEED) {
+        grounded_ = false;
+        jumping_ = false;
+    }
+}
+
+void Player::CheckLanding() {
+    int px = GetX();
+    int py = GetY() + HeightRadius();
+    int32_t sx[2] = {px - WIDTH_RADIUS, px + WIDTH_RADIUS};
+    int32_t sy[2] = {py, py};
+    int32_t distance[2];
+    uint8_t angle[2];
+    terrain_->Query(SensorDirection::Down, sx, sy, 2, distance, angle);
+
+    int nearest = distance[0] <= distance[1] ? 0 : 1;
+    int d = distance[nearest];
+    if (d >= 0 || d < -(ToPixels(ySpeed_) + 8)) return;
+
+    y_ += FromPixels(d);
+    Land((angle[nearest] & 1) ? 0 : angle[nearest]);
+}
+
+void Player::CheckCeiling() {
+    int px = GetX();
+    int py = GetY() - HeightRadius();
+    int32_t sx[2] = {px - WIDTH_RADIUS, px + WIDTH_RADIUS};
+    int32_t sy[2] = {py, py};
+    int32_t distance[2];
+    uint8_t angle[2];
+    terrain_->Query(SensorDirection::Up, sx, sy, 2, distance, angle);
+
+    int d = std::min(distance[0], distance[1]);
+    if (d >= 0) return;
+
+    y_ -= FromPixels(d);
+    ySpeed_ = 0;
+}
+
+void Player::Land(uint8_t angle) {
+    angle_ = angle;
+    grounded_ = true;
+    jumping_ = false;
+    if (rolling_) {
+        rolling_ = false;
+        y_ -= FromPixels(HEIGHT_RADIUS - ROLL_HEIGHT_RADIUS);
+    }
+
+    // Shallow floors keep horizontal speed, steeper ones convert the fall.
+    if (static_cast<uint8_t>(angle + 0x10) < 0x20) {
+        groundSpeed_ = xSpeed_;
+        ySpeed_ = 0;
+        return;
+    }
+    if (static_cast<uint8_t>(angle + 0x20) < 0x40) {
+        ySpeed_ >>= 1;
+    }
+    groundSpeed_ = angle >= 0x80 ? -ySpeed_ : ySpeed_;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "FixedMath.hpp"
+#include "level/TerrainCollision.hpp"
+#include <cstdint>
+
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool down = false;
+    bool jump = false;
+};
+
+// Sonic 2 ground, roll and air movement. Everything is integer math on
+// 1/256 pixel units, so a given input sequence always produces the same path.
+class Player {
+public:
+    explicit Player(const TerrainCollision* terrain);
+
+    void Reset(int x, int y);
+    void Update(const PlayerInput& input);
+
+    int GetX() const { return FixedMath::ToPixels(x_); }
+    int GetY() const { return FixedMath::ToPixels(y_); }
+    int32_t GetGroundSpeed() const { return groundSpeed_; }
+    uint8_t GetAngle() const { return angle_; }
+    bool IsGrounded() const { return grounded_; }
+    bool IsRolling() const { return rolling_; }
+
+private:
+    static constexpr int32_t ACCELERATION = 0x0C;
+    static constexpr int32_t DECELERATION = 0x80;
+    static constexpr int32_t FRICTION = 0x0C;
+    static constexpr int32_t TOP_SPEED = 0x600;
+    static constexpr int32_t SLOPE_FACTOR = 0x20;
+    static constexpr int32_t ROLL_SLOPE_FACTOR = 0x50;
+    static constexpr int32_t ROLL_FRICTION = 0x06;
+    static constexpr int32_t ROLL_DECELERATION = 0x20;
+    static constexpr int32_t ROLL_MIN_SPEED = 0x80;
+    static constexpr int32_t ROLL_TOP_SPEED = 0x1000;
+    static constexpr int32_t AIR_ACCELERATION = 0x18;
+    static constexpr int32_t GRAVITY = 0x38;
+    static constexpr int32_t JUMP_SPEED = 0x680;
+    static constexpr int32_t JUMP_RELEASE_SPEED = 0x400;
+    static constexpr int32_t MAX_FALL_SPEED = 0x1000;
+    static constexpr int32_t SLIP_SPEED = 0x280;
+
+    static constexpr int WIDTH_RADIUS = 9;
+    static constexpr int HEIGHT_RADIUS = 19;
+    static constexpr int ROLL_HEIGHT_RADIUS = 14;
+    static constexpr int PUSH_RADIUS = 10;
+    static constexpr int SNAP_DISTANCE = 14;
+
+    void UpdateGround(const PlayerInput& input);
+    void UpdateRolling(const PlayerInput& input);
+    void UpdateAir(const PlayerInput& input);
+
+    void ApplySlope(int32_t factor);
+    void Jump();
+    void ApplyGroundVelocity();
+    void CheckWalls();
+    void FollowFloor();
+    void CheckLanding();
+    void CheckCeiling();
+    void Land(uint8_t angle);
+    int HeightRadius() const { return rolling_ ? ROLL_HEIGHT_RADIUS : HEIGHT_RADIUS; }
+
+    const TerrainCollision* terrain_;
+    int32_t x_ = 0;
+    int32_t y_ = 0;
+    int32_t xSpeed_ = 0;
+    int32_t ySpeed_ = 0;
+    int32_t groundSpeed_ = 0;
+    uint8_t angle_ = 0;
+    bool grounded_ = false;
+    bool rolling_ = false;
+    bool jumping_ = false;
+    bool jumpHeld_ = false;
+};
@@ -0,0 +1,52 @@
+#include "AssetId.hpp"
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    std::string ToHex(uint64_t value) {
+        char text[19];
+        std::snprintf(text, sizeof(text), "0x%016llx", static_cast<unsigned long long>(value));
+        return text;
+    }
+
+#ifndef NDEBUG
+    std::string Normalize(std::string_view path) {
+        if (path.size() >= 2 && path[0] == '.' && (path[1] == '/' || path[1] == '\\')) {
+            path.remove_prefix(2);
+        }
+        std::string normalized(path);
+        for (char& c : normalized) {
+            if (c == '\\') c = '/';
+        }
+        return normalized;
+    }
+
+    std::mutex namesMutex;
+    std::unordered_map<uint64_t, std::string> names;
+#endif
+}
+
+void AssetId::RegisterName(uint64_t value, std::string_view path) {
+#ifndef NDEBUG
+    std::lock_guard<std::mutex> lock(namesMutex);
+    auto inserted = names.emplace(value, std::string(path));
+    if (!inserted.second && Normalize(inserted.first->second) != Normalize(path)) {
+        std::cerr << "Asset ID collision " << ToHex(value) << ": " << inserted.first->second
+                  << " and " << path << std::endl;
+    }
+#else
+    (void)value;
+    (void)path;
+#endif
+}
+
+std::string AssetId::GetName(uint64_t value) {
+#ifndef NDEBUG
+    std::lock_guard<std::mutex> lock(namesMutex);
+    auto found = names.find(value);
+    if (found != names.end()) return found->second;
+#endif
+    return ToHex(value);
+}
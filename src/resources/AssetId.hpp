@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+class AssetId;
+constexpr AssetId operator""_asset(const char* path, size_t length);
+
+// Names a data file by a 64-bit FNV-1a hash of its path under data/, the same
+// root ModIndex resolves, so lookups compare integers instead of strings.
+// IDs are only built from string literals ("SONICORCA/ENGINE.png"_asset),
+// hashed at compile time, and keep the literal for APIs that still take
+// paths. Paths only known at run time are hashed with Hash and passed as
+// values. Debug builds keep a reverse table so a bare value can be printed
+// as the path it came from.
+class AssetId {
+public:
+    constexpr AssetId() = default;
+
+    constexpr uint64_t GetValue() const { return value_; }
+    constexpr const char* GetPath() const { return path_; }
+    constexpr bool IsValid() const { return value_ != 0; }
+
+    // The engine's loaders and the game's own take paths under
+    // data/SONICORCA/ rather than data/.
+    constexpr bool IsUnder(std::string_view root) const {
+        if (!path_) return false;
+        for (size_t i = 0; i < root.size(); i++) {
+            if (path_[i] != root[i]) return false;
+        }
+        return true;
+    }
+    constexpr const char* GetSonicOrcaPath() const {
+        return IsUnder(SONICORCA_ROOT) ? path_ + SONICORCA_ROOT.size() : path_;
+    }
+
+    constexpr bool operator==(const AssetId& other) const { return value_ == other.value_; }
+    constexpr bool operator!=(const AssetId& other) const { return value_ != other.value_; }
+
+    // Backslashes count as forward slashes and a leading "./" is ignored,
+    // so the same file hashes the same however it was spelled.
+    static constexpr uint64_t Hash(std::string_view path) {
+        if (path.size() >= 2 && path[0] == '.' && (path[1] == '/' || path[1] == '\\')) {
+            path.remove_prefix(2);
+        }
+        uint64_t hash = OFFSET_BASIS;
+        for (char c : path) {
+            if (c == '\\') c = '/';
+            hash = (hash ^ static_cast<uint8_t>(c)) * PRIME;
+        }
+        return hash;
+    }
+
+    // RegisterName warns when two different paths hash alike. Both are
+    // no-ops under NDEBUG, where GetName only returns the value in hex.
+    static void RegisterName(uint64_t value, std::string_view path);
+    static std::string GetName(uint64_t value);
+
+    static constexpr std::string_view SONICORCA_ROOT = "SONICORCA/";
+    static constexpr uint64_t OFFSET_BASIS = 0xCBF29CE484222325ull;
+    static constexpr uint64_t PRIME = 0x100000001B3ull;
+
+private:
+    constexpr AssetId(const char* path, size_t length) : path_(path), value_(Hash(std::string_view(path, length))) {}
+    friend constexpr AssetId operator""_asset(const char* path, size_t length);
+
+    const char* path_ = nullptr;
+    uint64_t value_ = 0;
+};
+
+constexpr AssetId operator""_asset(const char* path, size_t length) {
+    return AssetId(path, length);
+}
+
+namespace std {
+    template <>
+    struct hash<AssetId> {
+        size_t operator()(const AssetId& id) const { return static_cast<size_t>(id.GetValue()); }
+    };
+}
@@ -0,0 +1,156 @@
+#include "TextureCache.hpp"
+#include "core/HitchDetector.hpp"
+#include "graphics/PremultipliedAlpha.hpp"
+#include "mods/ModIndex.hpp"
+#include <SDL2/SDL_image.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+SDL_Surface* TextureCache::LoadSurface(const std::string& dataPath) {
+    // Already-resolved paths (data/... without an override, or a mod's own)
+    // resolve to themselves.
+    const std::string prefix = "data/";
+    std::string path = dataPath.compare(0, prefix.size(), prefix) == 0
+        ? ModIndex::GetInstance().Resolve(dataPath.substr(prefix.size()))
+        : dataPath;
+
+    uint64_t size = 0;
+    int64_t time = 0;
+    bool stamped = GetSourceStamp(path, size, time);
+    std::string entryPath = GetEntryPath(path);
+
+    if (stamped) {
+        if (SDL_Surface* cached = ReadEntry(entryPath, size, time)) {
+            return cached;
+        }
+    }
+
+    SDL_Surface* surface = nullptr;
+    {
+        HitchDetector::Scope hitch(HitchEvent::Image, path);
+        surface = IMG_Load(path.c_str());
+    }
+    if (!surface) return nullptr;
+
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        surface = converted;
+        if (!surface) return nullptr;
+    }
+
+    if (stamped) {
+        WriteEntry(entryPath, surface, size, time);
+    }
+    return surface;
+}
+
+SDL_Texture* TextureCache::LoadTexture(SDL_Renderer* renderer, const std::string& path, bool premultiply) {
+    SDL_Surface* surface = LoadSurface(path);
+    if (!surface) return nullptr;
+
+    // Entries stay straight alpha; converting is cheap next to the decode.
+    premultiply = premultiply && PremultipliedAlpha::IsSupported(renderer) && PremultipliedAlpha::Convert(surface);
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                             surface->w, surface->h);
+    if (texture) {
+        SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch);
+        SDL_SetTextureBlendMode(texture, premultiply ? PremultipliedAlpha::GetBlendMode() : SDL_BLENDMODE_BLEND);
+    }
+    SDL_FreeSurface(surface);
+    return texture;
+}
+
+std::string TextureCache::GetEntryPath(const std::string& path) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : path) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ull;
+    }
+
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(CACHE_DIRECTORY) + "/" + name + ".bin";
+}
+
+bool TextureCache::GetSourceStamp(const std::string& path, uint64_t& size, int64_t& time) {
+    std::error_code error;
+    size = fs::file_size(path, error);
+    if (error) return false;
+    auto modified = fs::last_write_time(path, error);
+    if (error) return false;
+    time = static_cast<int64_t>(modified.time_since_epoch().count());
+    return true;
+}
+
+SDL_Surface* TextureCache::ReadEntry(const std::string& entryPath, uint64_t size, int64_t time) {
+    std::ifstream file(entryPath, std::ios::binary);
+    if (!file.is_open()) return nullptr;
+
+    Header header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return nullptr;
+    if (header.magic != MAGIC || header.version != VERSION ||
+        header.sourceSize != size || header.sourceTime != time ||
+        header.width == 0 || header.height == 0) {
+        return nullptr;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(header.width), static_cast<int>(header.height),
+                                                          32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) return nullptr;
+
+    // Rows are stored tightly packed; the surface pitch may be padded.
+    size_t rowBytes = static_cast<size_t>(header.width) * 4;
+    auto* pixels = static_cast<char*>(surface->pixels);
+    if (static_cast<size_t>(surface->pitch) == rowBytes) {
+        file.read(pixels, static_cast<std::streamsize>(rowBytes * header.height));
+    } else {
+        for (uint32_t y = 0; y < header.height && file; y++) {
+            file.read(pixels + static_cast<size_t>(y) * surface->pitch, static_cast<std::streamsize>(rowBytes));
+        }
+    }
+
+    if (!file) {
+        SDL_FreeSurface(surface);
+        return nullptr;
+    }
+    return surface;
+}
+
+void TextureCache::WriteEntry(const std::string& entryPath, SDL_Surface* surface, uint64_t size, int64_t time) {
+    std::error_code error;
+    fs::create_directories(CACHE_DIRECTORY, error);
+
+    // Write to a temporary name first so a crash never leaves a torn entry,
+    // and concurrent writers of the same entry cannot interleave.
+    std::string temporaryPath = entryPath + "." + std::to_string(reinterpret_cast<uintptr_t>(surface)) + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary);
+        if (!file.is_open()) return;
+
+        Header header = {MAGIC, VERSION, size, time, static_cast<uint32_t>(surface->w), static_cast<uint32_t>(surface->h)};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        size_t rowBytes = static_cast<size_t>(surface->w) * 4;
+        const auto* pixels = static_cast<const char*>(surface->pixels);
+        for (int y = 0; y < surface->h; y++) {
+            file.write(pixels + static_cast<size_t>(y) * surface->pitch, static_cast<std::streamsize>(rowBytes));
+        }
+        if (!file) {
+            file.close();
+            fs::remove(temporaryPath, error);
+            return;
+        }
+    }
+
+    fs::rename(temporaryPath, entryPath, error);
+    if (error) {
+        std::cerr << "Failed to write texture cache entry for " << entryPath << std::endl;
+        fs::remove(temporaryPath, error);
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+
+// On-disk cache of decoded images in ARGB8888, the format textures are
+// uploaded in. Paths under data/ go through ModIndex first, so moving a
+// loader onto the cache keeps its mod overrides. Entries are keyed by the
+// resolved source path and checked against the source's size and
+// modification time, so a changed file or a mod override pointing elsewhere
+// simply misses. Safe to call from loader threads.
+class TextureCache {
+public:
+    static SDL_Surface* LoadSurface(const std::string& path);
+    // With premultiply set, renderers that support it get a premultiplied
+    // texture with PremultipliedAlpha's blend mode; others a straight one.
+    static SDL_Texture* LoadTexture(SDL_Renderer* renderer, const std::string& path, bool premultiply = false);
+
+    static std::string GetEntryPath(const std::string& path);
+
+    static constexpr const char* CACHE_DIRECTORY = "cache/textures";
+    static constexpr uint32_t MAGIC = 0x58545348;  // "HSTX"
+    static constexpr uint32_t VERSION = 1;
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    static bool GetSourceStamp(const std::string& path, uint64_t& size, int64_t& time);
+    static SDL_Surface* ReadEntry(const std::string& entryPath, uint64_t size, int64_t time);
+    static void WriteEntry(const std::string& entryPath, SDL_Surface* surface, uint64_t size, int64_t time);
+};
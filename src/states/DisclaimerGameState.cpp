@@ -1,6 +1,10 @@
 #include "DisclaimerGameState.hpp"
 #include <core/GameContext.hpp>
 #include <resources/ResourceManager.hpp>
+#include "core/HitchDetector.hpp"
+#include "core/IdlePacer.hpp"
+#include "core/StartupTrace.hpp"
+#include <algorithm>
 #include <iostream>
 
 DisclaimerGameState::DisclaimerGameState(GameContext* gameContext)
@@ -26,6 +30,8 @@ DisclaimerGameState::~DisclaimerGameState() {
 }
 
 bool DisclaimerGameState::Initialize() {
+    StartupTrace::Scope trace("DisclaimerGameState::Initialize");
+    HitchDetector::Scope hitch(HitchEvent::Transition, "DisclaimerGameState::Initialize");
     disclaimerTexture_ = ResourceManager::GetInstance().LoadTexture("DISCLAIMER.png");
     if (!disclaimerTexture_) {
         std::cerr << "Failed to load DISCLAIMER.png" << std::endl;
@@ -36,12 +42,14 @@ bool DisclaimerGameState::Initialize() {
 }
 
 void DisclaimerGameState::Update() {
+    HitchDetector::GetInstance().MarkFrame();
+    int ticks = IdlePacer::GetInstance().Tick(IsIdle());
     if (!loaded_ || finished_) return;
 
     switch (phase_) {
         case Phase::Waiting:
             if (waitTimer_ > 0) {
-                --waitTimer_;
+                waitTimer_ = std::max(0, waitTimer_ - ticks);
             } else {
                 phase_ = Phase::FadingIn;
                 opacity_ = 0.0f;
@@ -56,7 +64,7 @@ void DisclaimerGameState::Update() {
             break;
         case Phase::Showing:
             if (showTimer_ > 0) {
-                --showTimer_;
+                showTimer_ = std::max(0, showTimer_ - ticks);
             } else {
                 phase_ = Phase::FadingOut;
             }
@@ -78,6 +86,7 @@ void DisclaimerGameState::Update() {
 void DisclaimerGameState::HandleEvent(const SDL_Event& event) {}
 
 void DisclaimerGameState::Render() {
+    StartupTrace::GetInstance().MarkFirstFrame();
     if (!loaded_ || !disclaimerTexture_) return;
 
     SDL_Renderer* renderer = gameContext_->GetRenderer();
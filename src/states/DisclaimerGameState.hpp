@@ -15,6 +15,7 @@ public:
     void Update() override;
     void Render() override;
     void HandleEvent(const SDL_Event& event) override;
+    bool IsIdle() const override { return loaded_ && (phase_ == Phase::Waiting || phase_ == Phase::Showing); }
 
     bool IsFinished() const { return finished_; }
 
@@ -5,8 +5,15 @@ class GameState {
 public:
     virtual ~GameState() = default;
  
+    // Called before Initialize, possibly on a loader thread. Anything that
+    // touches the renderer belongs in Initialize instead.
+    virtual bool Prepare() { return true; }
     virtual bool Initialize() = 0;
     virtual void Update() = 0;
     virtual void Render() = 0;
     virtual void HandleEvent(const SDL_Event& event) = 0;
+
+    // True while nothing on screen changes from one tick to the next, which
+    // lets the game tick and present less often.
+    virtual bool IsIdle() const { return false; }
 }; 
\ No newline at end of file
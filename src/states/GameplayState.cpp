@@ -1,9 +1,19 @@
 #include "GameplayState.hpp"
 #include <core/GameContext.hpp>
-#include <SDL2/SDL_image.h>
+#include <input/InputManager.hpp>
+#include "core/HitchDetector.hpp"
+#include "core/IdlePacer.hpp"
+#include "core/MemoryRegistry.hpp"
+#include "core/StatePreloader.hpp"
+#include "graphics/OverdrawMap.hpp"
+#include "graphics/UploadQueue.hpp"
+#include "input/InputRecorder.hpp"
+#include "resources/TextureCache.hpp"
 #include <sstream>
 #include <iomanip>
+#include <iostream>
 #include <cmath>
+#include <algorithm>
 
 GameplayState::GameplayState(GameContext* context) 
     : context_(context)
@@ -14,6 +24,7 @@ GameplayState::GameplayState(GameContext* context)
     , triangleTextureKnuckles_(nullptr)
     , lifeTextureSonic_(nullptr)
     , lifeTextureTails_(nullptr)
+    , prepared_(false)
     , score_(0)
     , time_(0)
     , rings_(0)
@@ -21,10 +32,19 @@ GameplayState::GameplayState(GameContext* context)
     , showMilliseconds_(true)
     , redAnimation_(0.0)
     , characterSelection_(0)
+    , cameraX_(0)
+    , cameraY_(0)
 {
 }
 
 GameplayState::~GameplayState() {
+    MemoryRegistry::GetInstance().UntrackOwner(MEMORY_OWNER);
+    for (uint64_t upload : uploads_) {
+        UploadQueue::GetInstance().Cancel(upload);
+    }
+    for (auto& pending : pendingTextures_) {
+        SDL_FreeSurface(pending.surface);
+    }
     if (checkeredTextureSonic_) SDL_DestroyTexture(checkeredTextureSonic_);
     if (checkeredTextureTails_) SDL_DestroyTexture(checkeredTextureTails_);
     if (triangleTextureSonic_) SDL_DestroyTexture(triangleTextureSonic_);
@@ -34,50 +54,146 @@ GameplayState::~GameplayState() {
     if (lifeTextureTails_) SDL_DestroyTexture(lifeTextureTails_);
 }
 
-bool GameplayState::Initialize() {
-    hudFont_ = std::make_unique<BitmapFont>();
-    if (!hudFont_->Load("data/SONICORCA/FONTS/HUD.font", context_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
-        return false;
+bool GameplayState::Prepare() {
+    if (prepared_) return true;
+
+    auto decodeTexture = [this](SDL_Texture* GameplayState::* texture, const char* path) {
+        SDL_Surface* surface = TextureCache::LoadSurface(path);
+        if (surface) pendingTextures_.push_back({texture, surface, path});
+    };
+
+    decodeTexture(&GameplayState::checkeredTextureSonic_, "data/SONICORCA/HUD/CHECKERED.png");
+    decodeTexture(&GameplayState::checkeredTextureTails_, "data/SONICORCA/HUD/CHECKERED/TAILS.png");
+    decodeTexture(&GameplayState::triangleTextureSonic_, "data/SONICORCA/HUD/TRIANGLE.png");
+    decodeTexture(&GameplayState::triangleTextureTails_, "data/SONICORCA/HUD/TRIANGLE/TAILS.png");
+    decodeTexture(&GameplayState::triangleTextureKnuckles_, "data/SONICORCA/HUD/TRIANGLE/KNUCKLES.png");
+    decodeTexture(&GameplayState::lifeTextureSonic_, "data/SONICORCA/HUD/LIFE/SONIC.png");
+    decodeTexture(&GameplayState::lifeTextureTails_, "data/SONICORCA/HUD/LIFE/TAILS.png");
+
+    sectionStreamer_ = std::make_unique<SectionStreamer>();
+    if (!sectionStreamer_->LoadAct(ACT_DIRECTORY)) {
+        std::cerr << "Failed to load act sections: " << ACT_DIRECTORY << std::endl;
     }
-    if (!hudFont_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYSILVER.png", context_->GetRenderer())) {
-        return false;
+
+    terrain_ = std::make_unique<TerrainCollision>();
+    if (!terrain_->Load(ACT_DIRECTORY)) {
+        std::cerr << "Failed to load act collision: " << ACT_DIRECTORY << std::endl;
     }
 
-    hudFontAlt_ = std::make_unique<BitmapFont>();
-    if (!hudFontAlt_->Load("data/SONICORCA/FONTS/HUD.font", context_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
-        return false;
+    objects_ = std::make_unique<ObjectSystem>();
+    objects_->LoadLayout(std::string(ACT_DIRECTORY) + "/OBJECTS.bin");
+
+    player_ = std::make_unique<Player>(terrain_.get());
+    player_->Reset(PLAYER_START_X, PLAYER_START_Y);
+
+    prepared_ = true;
+    return true;
+}
+
+bool GameplayState::Initialize() {
+    HitchDetector::Scope hitch(HitchEvent::Transition, "GameplayState::Initialize");
+    if (!prepared_) {
+        // The title prepares gameplay on a loader thread before the engine
+        // builds this instance; take that work over instead of repeating it.
+        std::unique_ptr<GameState> handed = StatePreloader::TakeHanded();
+        auto* prepared = dynamic_cast<GameplayState*>(handed.get());
+        if (prepared && prepared->prepared_) {
+            AdoptPrepared(*prepared);
+        } else if (!Prepare()) {
+            return false;
+        }
     }
-    if (!hudFontAlt_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYGOLD.png", context_->GetRenderer())) {
-        return false;
+
+    {
+        HitchDetector::Scope fontHitch(HitchEvent::Font, "FONTS/HUD.font");
+        hudFont_ = std::make_unique<BitmapFont>();
+        if (!hudFont_->Load("data/SONICORCA/FONTS/HUD.font", context_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
+            return false;
+        }
+        if (!hudFont_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYSILVER.png", context_->GetRenderer())) {
+            return false;
+        }
+
+        hudFontAlt_ = std::make_unique<BitmapFont>();
+        if (!hudFontAlt_->Load("data/SONICORCA/FONTS/HUD.font", context_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
+            return false;
+        }
+        if (!hudFontAlt_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYGOLD.png", context_->GetRenderer())) {
+            return false;
+        }
     }
 
-    auto loadTexture = [this](const std::string& path) -> SDL_Texture* {
-        SDL_Surface* surface = IMG_Load(path.c_str());
-        if (!surface) return nullptr;
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(context_->GetRenderer(), surface);
-        SDL_FreeSurface(surface);
-        return texture;
-    };
+    InputRecorder::GetInstance().Install();
 
-    checkeredTextureSonic_ = loadTexture("data/SONICORCA/HUD/CHECKERED.png");
-    checkeredTextureTails_ = loadTexture("data/SONICORCA/HUD/CHECKERED/TAILS.png");
-    triangleTextureSonic_ = loadTexture("data/SONICORCA/HUD/TRIANGLE.png");
-    triangleTextureTails_ = loadTexture("data/SONICORCA/HUD/TRIANGLE/TAILS.png");
-    triangleTextureKnuckles_ = loadTexture("data/SONICORCA/HUD/TRIANGLE/KNUCKLES.png");
-    lifeTextureSonic_ = loadTexture("data/SONICORCA/HUD/LIFE/SONIC.png");
-    lifeTextureTails_ = loadTexture("data/SONICORCA/HUD/LIFE/TAILS.png");
+    // Surfaces were decoded in Prepare. The uploads go through the frame
+    // budget instead of all landing in this frame.
+    MemoryRegistry& memory = MemoryRegistry::GetInstance();
+    for (auto& pending : pendingTextures_) {
+        SDL_Texture* GameplayState::* target = pending.target;
+        const char* path = pending.path;
+        uploads_.push_back(UploadQueue::GetInstance().Enqueue(pending.surface, UploadPriority::Now,
+            [this, target, path](SDL_Texture* texture) {
+                this->*target = texture;
+                MemoryRegistry::GetInstance().TrackTexture(texture, ResourceKind::Texture, MEMORY_OWNER, path);
+            }));
+    }
+    pendingTextures_.clear();
+    memory.TrackTexture(hudFont_->GetTexture(), ResourceKind::Font, MEMORY_OWNER, "FONTS/HUD.font");
+    memory.TrackTexture(hudFontAlt_->GetTexture(), ResourceKind::Font, MEMORY_OWNER, "FONTS/HUD.font (gold)");
 
     return true;
 }
 
+void GameplayState::AdoptPrepared(GameplayState& prepared) {
+    // Pending textures name their member rather than an address, so they
+    // land in this instance once uploaded.
+    pendingTextures_ = std::move(prepared.pendingTextures_);
+    prepared.pendingTextures_.clear();
+    sectionStreamer_ = std::move(prepared.sectionStreamer_);
+    terrain_ = std::move(prepared.terrain_);
+    objects_ = std::move(prepared.objects_);
+    player_ = std::move(prepared.player_);
+    characterSelection_ = prepared.characterSelection_;
+    prepared_ = true;
+}
+
 void GameplayState::Update() {
+    HitchDetector::GetInstance().MarkFrame();
+    IdlePacer::GetInstance().Tick(IsIdle());
+    InputRecorder::GetInstance().BeginTick();
+    UploadQueue::GetInstance().Process(context_->GetRenderer());
     redAnimation_ = fmod(redAnimation_ + 0.05, 2.0);
     
     time_++;
+
+    UpdatePlayer();
+    sectionStreamer_->Update(cameraX_);
+    objects_->Update(cameraX_, 1920);
+}
+
+void GameplayState::UpdatePlayer() {
+    using IM = InputManager;
+    const Uint8* keys = SDL_GetKeyboardState(nullptr);
+
+    PlayerInput input;
+    input.left = keys[IM::GetScancode(IM::KEY_LEFT)] != 0;
+    input.right = keys[IM::GetScancode(IM::KEY_RIGHT)] != 0;
+    input.down = keys[IM::GetScancode(IM::KEY_DOWN)] != 0;
+    // A tap that starts and ends between two ticks still counts as a jump.
+    SDL_Scancode jump = IM::GetScancode(IM::KEY_Z);
+    input.jump = keys[jump] != 0 || InputRecorder::GetInstance().WasPressed(jump);
+    player_->Update(input);
+
+    cameraX_ = std::max(0, player_->GetX() - 960);
+    cameraY_ = std::max(0, player_->GetY() - 540);
 }
 
 void GameplayState::Render() {
+    OverdrawMap& overdraw = OverdrawMap::GetInstance();
+    overdraw.BeginFrame(context_->GetRenderer());
+    sectionStreamer_->Render(context_->GetRenderer(), cameraX_, cameraY_, 1920, 1080);
     DrawHUD();
+    overdraw.EndFrame(context_->GetRenderer());
 }
 
 void GameplayState::DrawHUD() {
@@ -187,10 +303,17 @@ void GameplayState::DrawCharacterIcon(SDL_Texture* texture, int x, int y) {
     
     SDL_Rect dst = {x, y, 0, 0};
     SDL_QueryTexture(texture, nullptr, nullptr, &dst.w, &dst.h);
-    SDL_RenderCopy(context_->GetRenderer(), texture, nullptr, &dst);
+    OverdrawMap::Copy(context_->GetRenderer(), texture, nullptr, &dst);
 }
 
-void GameplayState::HandleEvent(const SDL_Event& event) {}
+void GameplayState::HandleEvent(const SDL_Event& event) {
+    if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F9) {
+        MemoryRegistry::GetInstance().DumpJson(MemoryRegistry::DUMP_PATH);
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F7) {
+        OverdrawMap::GetInstance().Toggle();
+    }
+}
 
 void GameplayState::SetCharacterSelection(int selection) {
     characterSelection_ = selection;
@@ -1,8 +1,13 @@
 #pragma once
 #include <core/GameContext.hpp>
 #include <graphics/BitmapFont.hpp>
+#include "level/SectionStreamer.hpp"
+#include "level/TerrainCollision.hpp"
+#include "objects/ObjectSystem.hpp"
+#include "player/Player.hpp"
 #include <memory>
 #include <string>
+#include <vector>
 #include <SDL2/SDL.h>
 
 class GameplayState : public GameState {
@@ -10,6 +15,7 @@ public:
     GameplayState(GameContext* context);
     ~GameplayState() override;
 
+    bool Prepare() override;
     bool Initialize() override;
     void Update() override;
     void Render() override;
@@ -18,11 +24,24 @@ public:
 
     void DrawCharacterIcon(SDL_Texture* texture, int x, int y);
     void SetCharacterSelection(int selection);
+    int GetCharacterSelection() const { return characterSelection_; }
+
+    static constexpr const char* MEMORY_OWNER = "Gameplay";
 
 private:
+    struct PendingTexture {
+        SDL_Texture* GameplayState::* target;
+        SDL_Surface* surface;
+        const char* path;
+    };
+
     GameContext* context_;
     std::unique_ptr<BitmapFont> hudFont_;
     std::unique_ptr<BitmapFont> hudFontAlt_;
+    std::unique_ptr<SectionStreamer> sectionStreamer_;
+    std::unique_ptr<TerrainCollision> terrain_;
+    std::unique_ptr<ObjectSystem> objects_;
+    std::unique_ptr<Player> player_;
     SDL_Texture* checkeredTextureSonic_;
     SDL_Texture* checkeredTextureTails_;
     SDL_Texture* triangleTextureSonic_;
@@ -30,6 +49,9 @@ private:
     SDL_Texture* triangleTextureKnuckles_;
     SDL_Texture* lifeTextureSonic_;
     SDL_Texture* lifeTextureTails_;
+    std::vector<PendingTexture> pendingTextures_;
+    std::vector<uint64_t> uploads_;
+    bool prepared_;
     
     int score_;
     int time_;
@@ -38,7 +60,15 @@ private:
     bool showMilliseconds_;
     double redAnimation_;
     int characterSelection_;  // 0 = Sonic & Tails, 1 = Sonic, 2 = Tails
+    int cameraX_;
+    int cameraY_;
+
+    static constexpr const char* ACT_DIRECTORY = "data/SONICORCA/LEVELS/EHZ/ACT1";
+    static constexpr int PLAYER_START_X = 0x60;
+    static constexpr int PLAYER_START_Y = 0x28F;
 
+    void AdoptPrepared(GameplayState& prepared);
+    void UpdatePlayer();
     void DrawHUD();
     void DrawScore();
     void DrawTime();
@@ -1,8 +1,19 @@
 #include "LogosGameState.hpp"
 #include <core/GameContext.hpp>
-#include <resources/ResourceManager.hpp>
+#include "core/HitchDetector.hpp"
+#include "core/IdlePacer.hpp"
+#include "core/MemoryRegistry.hpp"
+#include "graphics/OverdrawMap.hpp"
+#include "mods/ModIndex.hpp"
+#include "resources/TextureCache.hpp"
 #include <iostream>
 
+namespace {
+    constexpr AssetId ENGINE_TEXTURE = "SONICORCA/ENGINE.png"_asset;
+    constexpr AssetId ENGINE_PARTIAL_TEXTURE = "SONICORCA/ENGINE/PARTIAL.png"_asset;
+    constexpr AssetId ENGINE_SONIC_TEXTURE = "SONICORCA/ENGINE/SONIC.png"_asset;
+}
+
 LogosGameState::LogosGameState(GameContext* gameContext)
     : gameContext_(gameContext)
     , engineTexture_(nullptr)
@@ -21,20 +32,40 @@ LogosGameState::LogosGameState(GameContext* gameContext)
 {}
 
 LogosGameState::~LogosGameState() {
+    MemoryRegistry::GetInstance().UntrackOwner(MEMORY_OWNER);
     if (engineTexture_) SDL_DestroyTexture(engineTexture_);
     if (enginePartialTexture_) SDL_DestroyTexture(enginePartialTexture_);
     if (engineSonicTexture_) SDL_DestroyTexture(engineSonicTexture_);
 }
 
 bool LogosGameState::Initialize() {
-    engineTexture_ = ResourceManager::GetInstance().LoadTexture("ENGINE.png");
-    enginePartialTexture_ = ResourceManager::GetInstance().LoadTexture("ENGINE/PARTIAL.png");
-    engineSonicTexture_ = ResourceManager::GetInstance().LoadTexture("ENGINE/SONIC.png");
+    HitchDetector::Scope hitch(HitchEvent::Transition, "LogosGameState::Initialize");
+
+    // These are owned here, and the sprite sheet is large enough that
+    // skipping the PNG decode on later runs is worth it. Sonic is drawn at a
+    // quarter size at first, so everything is premultiplied to filter cleanly.
+    SDL_Renderer* renderer = gameContext_->GetRenderer();
+    ModIndex& mods = ModIndex::GetInstance();
+    engineTexture_ = TextureCache::LoadTexture(renderer, mods.Resolve(ENGINE_TEXTURE), true);
+    enginePartialTexture_ = TextureCache::LoadTexture(renderer, mods.Resolve(ENGINE_PARTIAL_TEXTURE), true);
+    std::string sonicPath = mods.Resolve(ENGINE_SONIC_TEXTURE);
+    engineSonicTexture_ = TextureCache::LoadTexture(renderer, sonicPath, true);
+
+    // A trimmed sheet from s2hdpp-trim carries its layout next to the image.
+    int sonicWidth = 0, sonicHeight = 0;
+    if (engineSonicTexture_) SDL_QueryTexture(engineSonicTexture_, nullptr, nullptr, &sonicWidth, &sonicHeight);
+    if (!sonicSheet_.Load(SpriteSheet::GetLayoutPath(sonicPath), sonicWidth, sonicHeight)) {
+        sonicSheet_.SetGrid(SONIC_CELL_WIDTH, SONIC_CELL_HEIGHT, SONIC_FRAMES);
+    }
 
     if (!engineTexture_ || !enginePartialTexture_ || !engineSonicTexture_) {
         std::cerr << "Failed to load one or more engine logo resources" << std::endl;
         return false;
     }
+    MemoryRegistry& memory = MemoryRegistry::GetInstance();
+    memory.TrackTexture(engineTexture_, ResourceKind::Texture, MEMORY_OWNER, "ENGINE.png");
+    memory.TrackTexture(enginePartialTexture_, ResourceKind::Texture, MEMORY_OWNER, "ENGINE/PARTIAL.png");
+    memory.TrackTexture(engineSonicTexture_, ResourceKind::Texture, MEMORY_OWNER, "ENGINE/SONIC.png");
     loaded_ = true;
     phase_ = Phase::SonicIn;
     timer_ = 8;
@@ -43,22 +74,35 @@ bool LogosGameState::Initialize() {
     sonicFrame_ = 0;
     smallSonic_ = true;
     fadeOpacity_ = 0.0f;
+    transition_.Clear();
+    fadeTicks_ = 0;
     finished_ = false;
 
-    font_ = std::make_unique<BitmapFont>();
-    if (!font_->Load("data/SONICORCA/FONTS/HUD.font", gameContext_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
-        std::cerr << "Failed to load HUD font" << std::endl;
-        return false;
-    }
-    if (!font_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYSILVER.png", gameContext_->GetRenderer())) {
-        std::cerr << "Failed to load HUD overlay" << std::endl;
-        return false;
+    fadeTrack_ = fadeTimeline_.AddTrack("fadeOpacity", {
+        {FADE_DELAY, 0.0f},
+        {FADE_DELAY + FADE_LENGTH, 1.0f}
+    });
+    fadeTimeline_.Load("data/S2HDPP/TIMELINES/LOGOS.json");
+
+    {
+        HitchDetector::Scope fontHitch(HitchEvent::Font, "FONTS/HUD.font");
+        font_ = std::make_unique<BitmapFont>();
+        if (!font_->Load("data/SONICORCA/FONTS/HUD.font", gameContext_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
+            std::cerr << "Failed to load HUD font" << std::endl;
+            return false;
+        }
+        if (!font_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYSILVER.png", gameContext_->GetRenderer())) {
+            std::cerr << "Failed to load HUD overlay" << std::endl;
+            return false;
+        }
     }
 
     return true;
 }
 
 void LogosGameState::Update() {
+    HitchDetector::GetInstance().MarkFrame();
+    IdlePacer::GetInstance().Tick(IsIdle());
     if (!loaded_ || finished_) return;
 
     switch (phase_) {
@@ -91,14 +135,14 @@ void LogosGameState::Update() {
             sonicFrame_ = (sonicFrame_ + 1) % 8;
             if (sonicX_ >= 2944) {
                 phase_ = Phase::FadeOut;
-                timer_ = 90;
+                fadeTicks_ = 0;
             }
             break;
         case Phase::FadeOut:
-            if (timer_ > 0) { timer_--; return; }
-            fadeOpacity_ += 1.0f / 60.0f;
-            if (fadeOpacity_ >= 1.0f) {
-                fadeOpacity_ = 1.0f;
+            fadeTimeline_.Evaluate(++fadeTicks_);
+            fadeOpacity_ = fadeTimeline_.Get(fadeTrack_);
+            transition_.SetOverlay({0, 0, 0, 255}, fadeOpacity_);
+            if (fadeTicks_ >= fadeTimeline_.GetDuration()) {
                 phase_ = Phase::Done;
                 finished_ = true;
             }
@@ -118,48 +162,44 @@ void LogosGameState::Render() {
     int winW, winH;
     SDL_GetRendererOutputSize(renderer, &winW, &winH);
 
-    if (smallSonic_) {
-        drawSmallSonic(renderer, winW, winH);
-    } else {
-        drawEngineLogo(renderer, winW, winH);
-        drawSonic(renderer, winW, winH);
+    OverdrawMap& overdraw = OverdrawMap::GetInstance();
+    overdraw.BeginFrame(renderer);
+    if (transition_.IsSceneVisible()) {
+        if (smallSonic_) {
+            drawSmallSonic(renderer, winW, winH);
+        } else {
+            drawEngineLogo(renderer, winW, winH);
+            drawSonic(renderer, winW, winH);
+        }
     }
+    transition_.Render(renderer);
+    overdraw.EndFrame(renderer);
+}
 
-    if (phase_ == Phase::FadeOut || phase_ == Phase::Done) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, static_cast<Uint8>(fadeOpacity_ * 255));
-        SDL_Rect rect = {0, 0, winW, winH};
-        SDL_RenderFillRect(renderer, &rect);
+void LogosGameState::HandleEvent(const SDL_Event& event) {
+    if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F7) {
+        OverdrawMap::GetInstance().Toggle();
     }
 }
 
-void LogosGameState::HandleEvent(const SDL_Event& event) {}
-
 void LogosGameState::drawEngineLogo(SDL_Renderer* renderer, int winW, int winH) {
     int texW, texH;
     SDL_QueryTexture(engineTexture_, nullptr, nullptr, &texW, &texH);
     SDL_Rect destRect = { winW/2 - texW/2, winH/2 - texH/2, texW, texH };
-    SDL_SetTextureBlendMode(engineTexture_, SDL_BLENDMODE_BLEND);
-    SDL_RenderCopy(renderer, engineTexture_, nullptr, &destRect);
+    OverdrawMap::Copy(renderer, engineTexture_, nullptr, &destRect);
 }
 
 void LogosGameState::drawSmallSonic(SDL_Renderer* renderer, int winW, int winH) {
-    int frameW = 1024, frameH = 1120;
     int dispW = 256, dispH = 280;
-    SDL_Rect srcRect = { sonicFrame_ * frameW, 0, frameW, frameH };
     SDL_Rect destRect = { sonicX_ - 128, 40, dispW, dispH };
-    SDL_SetTextureBlendMode(engineSonicTexture_, SDL_BLENDMODE_BLEND);
 
     SDL_RendererFlip flip = (sonicVX_ > 0) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderCopyEx(renderer, engineSonicTexture_, &srcRect, &destRect, 0, nullptr, flip);
+    OverdrawMap::GetInstance().Record(sonicSheet_.Draw(renderer, engineSonicTexture_, sonicFrame_, destRect, flip));
 }
 
 void LogosGameState::drawSonic(SDL_Renderer* renderer, int winW, int winH) {
-    int frameW = 1024, frameH = 1120;
-    SDL_Rect srcRect = { sonicFrame_ * frameW, 0, frameW, frameH };
-    SDL_Rect destRect = { sonicX_ - 512, -20, frameW, frameH };
-    SDL_SetTextureBlendMode(engineSonicTexture_, SDL_BLENDMODE_BLEND);
+    SDL_Rect destRect = { sonicX_ - 512, -20, SONIC_CELL_WIDTH, SONIC_CELL_HEIGHT };
 
     SDL_RendererFlip flip = (sonicVX_ > 0) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderCopyEx(renderer, engineSonicTexture_, &srcRect, &destRect, 0, nullptr, flip);
+    OverdrawMap::GetInstance().Record(sonicSheet_.Draw(renderer, engineSonicTexture_, sonicFrame_, destRect, flip));
 }
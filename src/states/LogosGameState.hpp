@@ -6,6 +6,9 @@
 #include <string>
 #include <vector>
 #include <graphics/BitmapFont.hpp>
+#include "graphics/SpriteSheet.hpp"
+#include "graphics/Timeline.hpp"
+#include "graphics/TransitionLayer.hpp"
 
 class GameContext;
 
@@ -18,9 +21,12 @@ public:
     void Update() override;
     void Render() override;
     void HandleEvent(const SDL_Event& event) override;
+    bool IsIdle() const override { return phase_ == Phase::Done; }
 
     bool IsFinished() const { return finished_; }
 
+    static constexpr const char* MEMORY_OWNER = "Logos";
+
 private:
     enum class Phase {
         Loading,
@@ -35,6 +41,7 @@ private:
     SDL_Texture* engineTexture_;
     SDL_Texture* enginePartialTexture_;
     SDL_Texture* engineSonicTexture_;
+    SpriteSheet sonicSheet_;
     bool loaded_;
     bool finished_;
 
@@ -45,6 +52,16 @@ private:
     int sonicFrame_;
     bool smallSonic_;
     float fadeOpacity_;
+    int fadeTicks_ = 0;
+    Timeline fadeTimeline_;
+    TransitionLayer transition_;
+    int fadeTrack_ = 0;
+
+    static constexpr int FADE_DELAY = 90;
+    static constexpr int FADE_LENGTH = 60;
+    static constexpr int SONIC_CELL_WIDTH = 1024;
+    static constexpr int SONIC_CELL_HEIGHT = 1120;
+    static constexpr int SONIC_FRAMES = 8;
 
     void drawPoweredBy(SDL_Renderer* renderer, int winW, int winH);
     void drawEngineLogo(SDL_Renderer* renderer, int winW, int winH);
@@ -1,6 +1,9 @@
 #include "TeamLogoGameState.hpp"
 #include <core/GameContext.hpp>
 #include <resources/ResourceManager.hpp>
+#include "core/HitchDetector.hpp"
+#include "core/IdlePacer.hpp"
+#include <algorithm>
 #include <iostream>
 
 TeamLogoGameState::TeamLogoGameState(GameContext* gameContext)
@@ -22,6 +25,7 @@ TeamLogoGameState::~TeamLogoGameState() {
 }
 
 bool TeamLogoGameState::Initialize() {
+    HitchDetector::Scope hitch(HitchEvent::Transition, "TeamLogoGameState::Initialize");
     logoTexture_ = ResourceManager::GetInstance().LoadTexture("TEAMLOGO.png");
     if (!logoTexture_) {
         std::cerr << "Failed to load TEAMLOGO.png" << std::endl;
@@ -36,6 +40,8 @@ bool TeamLogoGameState::Initialize() {
 }
 
 void TeamLogoGameState::Update() {
+    HitchDetector::GetInstance().MarkFrame();
+    int ticks = IdlePacer::GetInstance().Tick(IsIdle());
     if (!loaded_ || finished_) return;
 
     switch (phase_) {
@@ -48,7 +54,7 @@ void TeamLogoGameState::Update() {
             break;
         case Phase::Showing:
             if (showTimer_ > 0) {
-                --showTimer_;
+                showTimer_ = std::max(0, showTimer_ - ticks);
             } else {
                 phase_ = Phase::FadingOut;
             }
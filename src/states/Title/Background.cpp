@@ -1,20 +1,40 @@
 #include "Background.hpp"
 #include "TitleResources.hpp"
+#include "../TitleGameState.hpp"
+#include "core/HitchDetector.hpp"
+#include "graphics/FlashVariants.hpp"
+#include "graphics/OverdrawMap.hpp"
 #include <iostream>
 
 Background::Background(GameContext* context)
     : context_(context) {
-    backgroundSky_ = ResourceManager::GetInstance().LoadTexture(TitleResources::BACKGROUND_SKY);
-    backgroundIsland_ = ResourceManager::GetInstance().LoadTexture(TitleResources::BACKGROUND_ISLAND);
-    backgroundDeathEgg_ = ResourceManager::GetInstance().LoadTexture(TitleResources::BACKGROUND_DEATHEGG);
-    wipeTexture_ = ResourceManager::GetInstance().LoadTexture(TitleResources::WIPE);
+    auto load = [](const AssetId& asset) {
+        HitchDetector::Scope hitch(HitchEvent::Texture, asset.GetSonicOrcaPath());
+        return ResourceManager::GetInstance().LoadTexture(asset.GetSonicOrcaPath());
+    };
+    backgroundSky_ = load(TitleResources::BACKGROUND_SKY);
+    backgroundIsland_ = load(TitleResources::BACKGROUND_ISLAND);
+    backgroundDeathEgg_ = load(TitleResources::BACKGROUND_DEATHEGG);
+    wipeTexture_ = load(TitleResources::WIPE);
 
     if (!backgroundSky_ || !backgroundIsland_ || !backgroundDeathEgg_ || !wipeTexture_) {
         std::cerr << "Failed to load background textures!" << std::endl;
     }
+
+    // The flash after the white screen fades each layer from its silhouette.
+    FlashVariants& flash = FlashVariants::GetInstance();
+    SDL_Renderer* renderer = context_->GetRenderer();
+    skyFlash_ = flash.Get(renderer, backgroundSky_, TitleGameState::MEMORY_OWNER);
+    islandFlash_ = flash.Get(renderer, backgroundIsland_, TitleGameState::MEMORY_OWNER);
+    deathEggFlash_ = flash.Get(renderer, backgroundDeathEgg_, TitleGameState::MEMORY_OWNER);
 }
 
-Background::~Background() {}
+Background::~Background() {
+    FlashVariants& flash = FlashVariants::GetInstance();
+    flash.Release(backgroundSky_);
+    flash.Release(backgroundIsland_);
+    flash.Release(backgroundDeathEgg_);
+}
 
 void Background::Update() {
     if (ticks_ == 0) {
@@ -60,23 +80,24 @@ void Background::Render() {
     float x = backgroundSkyCentreX_;
     while (x - skyWidth / 2 < 1920) {
         SDL_Rect dest = {static_cast<int>(x - skyWidth / 2), 540 - skyHeight / 2, skyWidth, skyHeight};
-        SDL_RenderCopy(renderer, backgroundSky_, nullptr, &dest);
+        FlashVariants::Draw(renderer, backgroundSky_, skyFlash_, &dest, backgroundFlash_);
         x += skyWidth;
     }
 
     int deathEggWidth = 0, deathEggHeight = 0;
     SDL_QueryTexture(backgroundDeathEgg_, nullptr, nullptr, &deathEggWidth, &deathEggHeight);
     SDL_Rect deathEggDest = {1750 - deathEggWidth / 2, 192 - deathEggHeight / 2, deathEggWidth, deathEggHeight};
-    SDL_RenderCopy(renderer, backgroundDeathEgg_, nullptr, &deathEggDest);
+    FlashVariants::Draw(renderer, backgroundDeathEgg_, deathEggFlash_, &deathEggDest, backgroundFlash_);
 
     int islandWidth = 0, islandHeight = 0;
     SDL_QueryTexture(backgroundIsland_, nullptr, nullptr, &islandWidth, &islandHeight);
     SDL_Rect islandDest = {static_cast<int>(backgroundIslandCentreX_ - islandWidth / 2), 540 - islandHeight / 2, islandWidth, islandHeight};
-    SDL_RenderCopy(renderer, backgroundIsland_, nullptr, &islandDest);
+    FlashVariants::Draw(renderer, backgroundIsland_, islandFlash_, &islandDest, backgroundFlash_);
 
-    if (backgroundFlash_ > 0.0f) {
+    // Without render targets there are no variants; flash the whole screen.
+    if (backgroundFlash_ > 0.0f && (!skyFlash_ || !islandFlash_ || !deathEggFlash_)) {
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, static_cast<Uint8>(backgroundFlash_ * 255));
-        SDL_RenderFillRect(renderer, nullptr);
+        OverdrawMap::FillRect(renderer, nullptr);
     }
 
     if (wipeHeight_ > 0) {
@@ -84,10 +105,10 @@ void Background::Render() {
         SDL_QueryTexture(wipeTexture_, nullptr, nullptr, &wipeWidth, &wipeHeight);
         
         SDL_Rect topWipeDest = {0, wipeHeight_ - wipeHeight, wipeWidth, wipeHeight};
-        SDL_RenderCopy(renderer, wipeTexture_, nullptr, &topWipeDest);
+        OverdrawMap::Copy(renderer, wipeTexture_, nullptr, &topWipeDest);
         
         SDL_Rect bottomWipeDest = {0, 1080 - wipeHeight_, wipeWidth, wipeHeight};
-        SDL_RenderCopyEx(renderer, wipeTexture_, nullptr, &bottomWipeDest, 0, nullptr, SDL_FLIP_VERTICAL);
+        OverdrawMap::CopyEx(renderer, wipeTexture_, nullptr, &bottomWipeDest, 0, nullptr, SDL_FLIP_VERTICAL);
     }
 }
 
@@ -24,6 +24,9 @@ private:
     SDL_Texture* backgroundIsland_ = nullptr;
     SDL_Texture* backgroundDeathEgg_ = nullptr;
     SDL_Texture* wipeTexture_ = nullptr;
+    SDL_Texture* skyFlash_ = nullptr;
+    SDL_Texture* islandFlash_ = nullptr;
+    SDL_Texture* deathEggFlash_ = nullptr;
     
     float backgroundSkyCentreX_ = 1260.0f;
     float backgroundIslandCentreX_ = 1088.0f;
@@ -1,7 +1,7 @@
 #include "TitleResources.hpp"
 
 namespace TitleResources {
-    std::vector<std::string> GetAllResourcePaths() {
+    std::vector<AssetId> GetAllResources() {
         return {
             ANIMATION_GROUP,
             FONT,
@@ -14,4 +14,13 @@ namespace TitleResources {
             WIPE
         };
     }
+
+    std::vector<AssetId> GetTextures() {
+        return {
+            BACKGROUND_SKY,
+            BACKGROUND_ISLAND,
+            BACKGROUND_DEATHEGG,
+            WIPE
+        };
+    }
 } 
\ No newline at end of file
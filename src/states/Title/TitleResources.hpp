@@ -1,18 +1,27 @@
 #pragma once
 
+#include "resources/AssetId.hpp"
 #include <string>
 #include <vector>
 
 namespace TitleResources {
-    const std::string ANIMATION_GROUP = "TITLE/ANIGROUP";
-    const std::string FONT = "FONTS/HUD.font";
-    const std::string SPARKLE_SOUND = "SOUND/SPARKLE";
-    const std::string SHOOTING_STAR_SOUND = "SOUND/SHOOTINGSTAR";
-    const std::string MUSIC = "TITLE/MUSIC";
-    const std::string BACKGROUND_SKY = "TITLE/BACKGROUND/SKY.png";
-    const std::string BACKGROUND_ISLAND = "TITLE/BACKGROUND/ISLAND.png";
-    const std::string BACKGROUND_DEATHEGG = "TITLE/BACKGROUND/DEATHEGG.png";
-    const std::string WIPE = "TITLE/WIPE.png";
+    constexpr AssetId ANIMATION_GROUP = "SONICORCA/TITLE/ANIGROUP"_asset;
+    constexpr AssetId FONT = "SONICORCA/FONTS/HUD.font"_asset;
+    constexpr AssetId SPARKLE_SOUND = "SONICORCA/SOUND/SPARKLE"_asset;
+    constexpr AssetId SHOOTING_STAR_SOUND = "SONICORCA/SOUND/SHOOTINGSTAR"_asset;
+    constexpr AssetId MUSIC = "SONICORCA/TITLE/MUSIC"_asset;
+    constexpr AssetId BACKGROUND_SKY = "SONICORCA/TITLE/BACKGROUND/SKY.png"_asset;
+    constexpr AssetId BACKGROUND_ISLAND = "SONICORCA/TITLE/BACKGROUND/ISLAND.png"_asset;
+    constexpr AssetId BACKGROUND_DEATHEGG = "SONICORCA/TITLE/BACKGROUND/DEATHEGG.png"_asset;
+    constexpr AssetId WIPE = "SONICORCA/TITLE/WIPE.png"_asset;
+
+    // IDs are rooted at data/ like ModIndex's, so Resolve finds overrides;
+    // loaders that want data/SONICORCA/ paths use GetSonicOrcaPath.
+    static_assert(ANIMATION_GROUP.IsUnder(AssetId::SONICORCA_ROOT) && FONT.IsUnder(AssetId::SONICORCA_ROOT) &&
+                  SPARKLE_SOUND.IsUnder(AssetId::SONICORCA_ROOT) && SHOOTING_STAR_SOUND.IsUnder(AssetId::SONICORCA_ROOT) &&
+                  MUSIC.IsUnder(AssetId::SONICORCA_ROOT) && BACKGROUND_SKY.IsUnder(AssetId::SONICORCA_ROOT) &&
+                  BACKGROUND_ISLAND.IsUnder(AssetId::SONICORCA_ROOT) && BACKGROUND_DEATHEGG.IsUnder(AssetId::SONICORCA_ROOT) &&
+                  WIPE.IsUnder(AssetId::SONICORCA_ROOT), "title IDs must use ModIndex's root");
 
     const int HD_ANIMATION = 0;
     const int THE_HEDGEHOG_ANIMATION = 1;
@@ -26,5 +35,6 @@ namespace TitleResources {
     const int SHOOTING_STAR_ANIMATION = 9;
     const int WATER_SPARKLE_ANIMATION = 10;
 
-    std::vector<std::string> GetAllResourcePaths();
+    std::vector<AssetId> GetAllResources();
+    std::vector<AssetId> GetTextures();
 }; 
\ No newline at end of file
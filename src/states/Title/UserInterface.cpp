@@ -1,5 +1,10 @@
 #include "UserInterface.hpp"
 #include "../TitleGameState.hpp"
+#include "core/HitchDetector.hpp"
+#include "core/MemoryRegistry.hpp"
+#include "graphics/FlashVariants.hpp"
+#include "graphics/OverdrawMap.hpp"
+#include "graphics/PremultipliedAlpha.hpp"
 #include <input/InputManager.hpp>
 #include <resources/ResourceManager.hpp>
 #include <iostream>
@@ -29,24 +34,86 @@ UserInterface::UserInterface(GameContext* gameContext, TitleGameState* titleGame
     , demoTimeout_(720)
     , characterSelectTimer_(60)
 {
-    textureSelectionMarker_ = ResourceManager::GetInstance().LoadTexture("TITLE/SELECTIONMARKER.png");
-    textureZigZag_ = ResourceManager::GetInstance().LoadTexture("TITLE/ZIGZAG.png");
-    textureLeftArrow_ = ResourceManager::GetInstance().LoadTexture("MENU/LEFT.png");
-    textureRightArrow_ = ResourceManager::GetInstance().LoadTexture("MENU/RIGHT.png");
-
-    fontImpactRegular_ = std::make_unique<BitmapFont>();
-    fontImpactItalic_ = std::make_unique<BitmapFont>();
-    if (!fontImpactRegular_->Load("data/SONICORCA/FONTS/IMPACT/REGULAR.font", gameContext_->GetRenderer(), "data/SONICORCA/FONTS/IMPACT/REGULAR") ||
-        !fontImpactItalic_->Load("data/SONICORCA/FONTS/IMPACT/ITALIC.font", gameContext_->GetRenderer(), "data/SONICORCA/FONTS/IMPACT/ITALIC")) {
-        std::cerr << "Failed to load fonts!" << std::endl;
+    auto load = [](const char* path) {
+        HitchDetector::Scope hitch(HitchEvent::Texture, path);
+        return ResourceManager::GetInstance().LoadTexture(path);
+    };
+    textureSelectionMarker_ = load("TITLE/SELECTIONMARKER.png");
+    textureZigZag_ = load("TITLE/ZIGZAG.png");
+    textureLeftArrow_ = load("MENU/LEFT.png");
+    textureRightArrow_ = load("MENU/RIGHT.png");
+
+    {
+        HitchDetector::Scope hitch(HitchEvent::Font, "FONTS/IMPACT");
+        fontImpactRegular_ = std::make_unique<BitmapFont>();
+        fontImpactItalic_ = std::make_unique<BitmapFont>();
+        if (!fontImpactRegular_->Load("data/SONICORCA/FONTS/IMPACT/REGULAR.font", gameContext_->GetRenderer(), "data/SONICORCA/FONTS/IMPACT/REGULAR") ||
+            !fontImpactItalic_->Load("data/SONICORCA/FONTS/IMPACT/ITALIC.font", gameContext_->GetRenderer(), "data/SONICORCA/FONTS/IMPACT/ITALIC")) {
+            std::cerr << "Failed to load fonts!" << std::endl;
+        }
     }
 
+    MemoryRegistry& memory = MemoryRegistry::GetInstance();
+    const char* owner = TitleGameState::MEMORY_OWNER;
+    memory.TrackSharedTexture(textureSelectionMarker_, ResourceKind::Texture, owner, "TITLE/SELECTIONMARKER.png");
+    memory.TrackSharedTexture(textureZigZag_, ResourceKind::Texture, owner, "TITLE/ZIGZAG.png");
+    memory.TrackSharedTexture(textureLeftArrow_, ResourceKind::Texture, owner, "MENU/LEFT.png");
+    memory.TrackSharedTexture(textureRightArrow_, ResourceKind::Texture, owner, "MENU/RIGHT.png");
+    memory.TrackTexture(fontImpactRegular_->GetTexture(), ResourceKind::Font, owner, "FONTS/IMPACT/REGULAR.font");
+    memory.TrackTexture(fontImpactItalic_->GetTexture(), ResourceKind::Font, owner, "FONTS/IMPACT/ITALIC.font");
 
+
+    CreatePressStartLabel();
+    InitialiseTimelines();
     InitialiseMenuItemWidgets();
     InitialiseLevelSelect();
 }
 
-UserInterface::~UserInterface() {}
+UserInterface::~UserInterface() {
+    if (pressStartLabel_) {
+        FlashVariants::GetInstance().Release(pressStartLabel_);
+        SDL_DestroyTexture(pressStartLabel_);
+    }
+}
+
+void UserInterface::CreatePressStartLabel() {
+    if (!fontImpactItalic_) return;
+    SDL_Renderer* renderer = gameContext_->GetRenderer();
+
+    // Rendering onto transparent black leaves the label premultiplied, which
+    // straight blending would draw with dark fringes; without the custom
+    // blend mode DrawPressStart keeps drawing the text directly.
+    if (!PremultipliedAlpha::IsSupported(renderer)) return;
+
+    // The text never changes, so it is drawn once into a texture that can be
+    // scaled and flashed as a whole. Target contents are lost when the
+    // device resets, so the result is read back into a static texture.
+    const std::string text = "PRESS START";
+    int width = fontImpactItalic_->GetTextWidth(text);
+    int height = fontImpactItalic_->GetHeight();
+    if (width <= 0 || height <= 0) return;
+    SDL_Texture* target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!target) return;
+
+    std::vector<Uint32> pixels(static_cast<size_t>(width) * height);
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, target);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    fontImpactItalic_->RenderText(renderer, text, 0, 0, true);
+    int read = SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(), width * static_cast<int>(sizeof(Uint32)));
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_DestroyTexture(target);
+    if (read != 0) return;
+
+    pressStartLabel_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height);
+    if (!pressStartLabel_) return;
+    SDL_UpdateTexture(pressStartLabel_, nullptr, pixels.data(), width * static_cast<int>(sizeof(Uint32)));
+
+    SDL_SetTextureBlendMode(pressStartLabel_, PremultipliedAlpha::GetBlendMode());
+    pressStartFlash_ = FlashVariants::GetInstance().Get(renderer, pressStartLabel_, TitleGameState::MEMORY_OWNER);
+    MemoryRegistry::GetInstance().TrackTexture(pressStartLabel_, ResourceKind::Font, TitleGameState::MEMORY_OWNER, "PRESS START label");
+}
 
 void UserInterface::Reset() {
     ticks_ = 0;
@@ -75,26 +142,14 @@ void UserInterface::Update() {
     ticks_++;
 
     if (!pressStartActive_ && busy_) {
-        if (pressStartScale_ > 1.0f) {
-            pressStartScale_ = std::max(1.0f, pressStartScale_ - 0.04f);
-        }
-        
-        if (pressStartWhiteAdditive_ > 0.0f) {
-            pressStartWhiteAdditive_ = std::max(0.0f, pressStartWhiteAdditive_ - 0.1f);
-        }
-        
-        if (textOpacity_ < 1.0f) {
-            textOpacity_ = std::min(1.0f, textOpacity_ + 0.1f);
-        }
-        if (textWhiteAdditive_ > 0.0f) {
-            textWhiteAdditive_ = std::max(0.0f, textWhiteAdditive_ - 0.1f);
-        }
-        
-        if (pressStartOpacity_ > 0.0f) {
-            pressStartOpacity_ = std::max(0.0f, pressStartOpacity_ - 0.1f);
-        }
-
-        if (pressStartOpacity_ == 0.0f && textOpacity_ == 1.0f) {
+        pressStartTimeline_.Evaluate(++pressStartTicks_);
+        pressStartScale_ = pressStartTimeline_.Get(pressStartScaleTrack_);
+        pressStartWhiteAdditive_ = pressStartTimeline_.Get(pressStartWhiteAdditiveTrack_);
+        pressStartOpacity_ = pressStartTimeline_.Get(pressStartOpacityTrack_);
+        textOpacity_ = pressStartTimeline_.Get(textOpacityTrack_);
+        textWhiteAdditive_ = pressStartTimeline_.Get(textWhiteAdditiveTrack_);
+
+        if (pressStartTicks_ >= pressStartTimeline_.GetDuration()) {
             busy_ = false;
         }
     }
@@ -124,10 +179,11 @@ void UserInterface::Update() {
     }
 
     if (markerAnimating_) {
-        float t = static_cast<float>(markerAnimFrame_) / markerAnimLength_;
+        markerTimeline_.Evaluate(markerAnimFrame_);
+        float t = markerTimeline_.Get(markerProgressTrack_);
+        float hop = markerTimeline_.Get(markerHopTrack_);
         for (int i = 0; i < 2; ++i) {
             markerPositions_[i].x = markerStart_[i].x + (markerTarget_[i].x - markerStart_[i].x) * t;
-            float hop = -32.0f * std::sin(3.14159f * t);
             markerPositions_[i].y = markerStart_[i].y + (markerTarget_[i].y - markerStart_[i].y) * t + hop;
         }
         markerAnimFrame_++;
@@ -179,11 +235,13 @@ void UserInterface::HandleInput() {
     if (pressStartActive_) {
         if (IM::justPressed(IM::GetScancode(IM::KEY_ENTER))) {
             busy_ = true;
-            pressStartScale_ = 1.2f;  
-            pressStartWhiteAdditive_ = 1.0f;  
-            pressStartOpacity_ = 1.0f;
-            textOpacity_ = 0.0f;  
-            textWhiteAdditive_ = 1.0f;
+            pressStartTicks_ = 0;
+            pressStartTimeline_.Evaluate(0);
+            pressStartScale_ = pressStartTimeline_.Get(pressStartScaleTrack_);
+            pressStartWhiteAdditive_ = pressStartTimeline_.Get(pressStartWhiteAdditiveTrack_);
+            pressStartOpacity_ = pressStartTimeline_.Get(pressStartOpacityTrack_);
+            textOpacity_ = pressStartTimeline_.Get(textOpacityTrack_);
+            textWhiteAdditive_ = pressStartTimeline_.Get(textWhiteAdditiveTrack_);
             pressStartActive_ = false;
             demoTimeout_ = 0;
         }
@@ -252,6 +310,25 @@ void UserInterface::HandleInput() {
     }
 }
 
+void UserInterface::InitialiseTimelines() {
+    pressStartScaleTrack_ = pressStartTimeline_.AddTrack("pressStartScale", {{0, 1.2f}, {5, 1.0f}});
+    pressStartWhiteAdditiveTrack_ = pressStartTimeline_.AddTrack("pressStartWhiteAdditive", {{0, 1.0f}, {10, 0.0f}});
+    pressStartOpacityTrack_ = pressStartTimeline_.AddTrack("pressStartOpacity", {{0, 1.0f}, {10, 0.0f}});
+    textOpacityTrack_ = pressStartTimeline_.AddTrack("textOpacity", {{0, 0.0f}, {10, 1.0f}});
+    textWhiteAdditiveTrack_ = pressStartTimeline_.AddTrack("textWhiteAdditive", {{0, 1.0f}, {10, 0.0f}});
+
+    markerProgressTrack_ = markerTimeline_.AddTrack("markerProgress", {{0, 0.0f}, {10, 1.0f}});
+    markerHopTrack_ = markerTimeline_.AddTrack("markerHop", {
+        {0, 0.0f, Interpolation::SineOut},
+        {5, -32.0f, Interpolation::SineIn},
+        {10, 0.0f}
+    });
+
+    // Optional overrides, so the curves can be tuned without recompiling.
+    pressStartTimeline_.Load(TIMELINE_PATH);
+    markerTimeline_.Load(TIMELINE_PATH);
+}
+
 void UserInterface::InitialiseMenuItemWidgets() {
     menuItems_.clear();
     menuItems_.push_back(MenuItem("QUIT", [this]() { OnSelectQuit(); }));
@@ -361,7 +438,12 @@ void UserInterface::DrawPressStart() {
     };
 
     fontImpactItalic_->RenderText(renderer, text, x + 2, y + 2, false);
-    
+
+    if (pressStartLabel_ && pressStartFlash_) {
+        FlashVariants::Draw(renderer, pressStartLabel_, pressStartFlash_, &destRect, pressStartWhiteAdditive_);
+        return;
+    }
+
     SDL_SetTextureColorMod(fontImpactItalic_->GetTexture(),
         255,
         static_cast<Uint8>(255 * (1.0f - pressStartWhiteAdditive_)),
@@ -380,7 +462,7 @@ void UserInterface::DrawZigZag(int x, int y, int width, int animOffset) {
     int drawX = x - animOffset;
     while (drawX < x + width) {
         SDL_Rect dst = { drawX, y - texH / 2, texW, texH };
-        SDL_RenderCopy(renderer, textureZigZag_, nullptr, &dst);
+        OverdrawMap::Copy(renderer, textureZigZag_, nullptr, &dst);
         drawX += texW;
     }
 }
@@ -403,11 +485,11 @@ void UserInterface::DrawMenuItems() {
 
         
         SDL_Rect leftDst = { static_cast<int>(markerPositions_[0].x), static_cast<int>(markerPositions_[0].y), markerWidth, markerHeight };
-        SDL_RenderCopy(renderer, textureSelectionMarker_, nullptr, &leftDst);
+        OverdrawMap::Copy(renderer, textureSelectionMarker_, nullptr, &leftDst);
 
         
         SDL_Rect rightDst = { static_cast<int>(markerPositions_[1].x), static_cast<int>(markerPositions_[1].y), markerWidth, markerHeight };
-        SDL_RenderCopyEx(renderer, textureSelectionMarker_, nullptr, &rightDst, 0, nullptr, SDL_FLIP_HORIZONTAL);
+        OverdrawMap::CopyEx(renderer, textureSelectionMarker_, nullptr, &rightDst, 0, nullptr, SDL_FLIP_HORIZONTAL);
     }
     
     
@@ -437,7 +519,7 @@ void UserInterface::DrawCharacterSelect() {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, static_cast<Uint8>(192 * characterSelectOpacity_));
     SDL_Rect overlayRect = { 0, 800, 1920, 200 };
-    SDL_RenderFillRect(renderer, &overlayRect);
+    OverdrawMap::FillRect(renderer, &overlayRect);
 
     std::string title = "SELECT CHARACTER";
     int titleWidth = fontImpactRegular_->GetTextWidth(title);
@@ -457,16 +539,16 @@ void UserInterface::DrawCharacterSelect() {
         if (i == selected) {
             if (textureLeftArrow_) {
                 SDL_Rect leftArrow = { x - 48, y, 32, 32 };
-                SDL_RenderCopy(renderer, textureLeftArrow_, nullptr, &leftArrow);
+                OverdrawMap::Copy(renderer, textureLeftArrow_, nullptr, &leftArrow);
             }
             if (textureRightArrow_) {
                 SDL_Rect rightArrow = { x + textWidth + 16, y, 32, 32 };
-                SDL_RenderCopy(renderer, textureRightArrow_, nullptr, &rightArrow);
+                OverdrawMap::Copy(renderer, textureRightArrow_, nullptr, &rightArrow);
             }
 
             SDL_SetRenderDrawColor(renderer, 255, 255, 0, static_cast<Uint8>(255 * characterSelectOpacity_));
             SDL_Rect highlight = { x - 16, y - 8, textWidth + 32, 64 };
-            SDL_RenderFillRect(renderer, &highlight);
+            OverdrawMap::FillRect(renderer, &highlight);
         }
 
         SDL_SetTextureAlphaMod(fontImpactRegular_->GetTexture(), static_cast<Uint8>(255 * characterSelectOpacity_));
@@ -512,5 +594,6 @@ void UserInterface::StartMarkerTween(int newSelection) {
     markerTarget_[1] = { static_cast<float>(newWidget.x + newMarkerOffset - markerWidth), static_cast<float>(newY) };
 
     markerAnimFrame_ = 0;
+    markerAnimLength_ = markerTimeline_.GetDuration();
     markerAnimating_ = true;
 } 
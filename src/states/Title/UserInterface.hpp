@@ -2,6 +2,7 @@
 
 #include <core/GameContext.hpp>
 #include <graphics/BitmapFont.hpp>
+#include "graphics/Timeline.hpp"
 #include <SDL2/SDL.h>
 #include <memory>
 #include <string>
@@ -56,6 +57,7 @@ private:
         float x, y;
     };
 
+    void InitialiseTimelines();
     void HandleInput();
     void InitialiseMenuItemWidgets();
     void SetSelectionMarkerPositions();
@@ -69,6 +71,7 @@ private:
     void StartDemo();
     void OnLevelSelectStart();
     void ApplyCharacterSelection();
+    void CreatePressStartLabel();
     void DrawPressStart();
     void DrawZigZag();
     void DrawMenuItems();
@@ -111,6 +114,8 @@ private:
     SDL_Texture* textureRightArrow_ = nullptr;
     std::unique_ptr<BitmapFont> fontImpactRegular_;
     std::unique_ptr<BitmapFont> fontImpactItalic_;
+    SDL_Texture* pressStartLabel_ = nullptr;
+    SDL_Texture* pressStartFlash_ = nullptr;
 
     MarkerPos markerPositions_[2];
     MarkerPos markerStart_[2];
@@ -119,40 +124,16 @@ private:
     int markerAnimLength_ = 10;
     bool markerAnimating_ = false;
 
-    float GetPressStartScaleX(int t) {
-        if (t <= 5) return 1.0f;
-        if (t <= 10) return 1.2f;
-        if (t <= 20) return 0.0f;
-        return 0.0f;
-    }
-
-    float GetPressStartScaleY(int t) {
-        if (t <= 5) return 1.45f;
-        if (t <= 10) return 1.0f;
-        if (t <= 20) return 0.0f;
-        return 0.0f;
-    }
-
-    float GetPressStartWhiteAdditive(int t) {
-        if (t <= 10) return t / 10.0f;
-        return 1.0f;
-    }
-
-    float GetPressStartOpacity(int t) {
-        if (t <= 10) return 1.0f;
-        if (t <= 20) return 1.0f - (t - 10) / 10.0f;
-        return 0.0f;
-    }
-
-    float GetTextOpacity(int t) {
-        if (t <= 20) return 0.0f;
-        if (t <= 30) return (t - 20) / 10.0f;
-        return 1.0f;
-    }
-
-    float GetTextWhiteAdditive(int t) {
-        if (t <= 20) return 1.0f;
-        if (t <= 30) return 1.0f - (t - 20) / 10.0f;
-        return 0.0f;
-    }
+    Timeline pressStartTimeline_;
+    Timeline markerTimeline_;
+    int pressStartTicks_ = 0;
+    int pressStartScaleTrack_ = 0;
+    int pressStartWhiteAdditiveTrack_ = 0;
+    int pressStartOpacityTrack_ = 0;
+    int textOpacityTrack_ = 0;
+    int textWhiteAdditiveTrack_ = 0;
+    int markerProgressTrack_ = 0;
+    int markerHopTrack_ = 0;
+
+    static constexpr const char* TIMELINE_PATH = "data/S2HDPP/TIMELINES/TITLEUI.json";
 }; 
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "TitleGameState.hpp"
 #include "Title/Background.hpp"
 #include "Title/TitleResources.hpp"
+#include "audio/AudioMixer.hpp"
+#include "core/HitchDetector.hpp"
+#include "core/IdlePacer.hpp"
+#include "core/MemoryRegistry.hpp"
+#include "graphics/OverdrawMap.hpp"
 #include <graphics/BitmapFont.hpp>
 #include <input/InputManager.hpp>
 #include <core/GameContext.hpp>
@@ -10,29 +15,78 @@ TitleGameState::TitleGameState(GameContext* context)
     : context_(context), font_(nullptr) {
 }
 
-TitleGameState::~TitleGameState() = default;
+TitleGameState::~TitleGameState() {
+    MemoryRegistry::GetInstance().UntrackOwner(MEMORY_OWNER);
+}
 
 bool TitleGameState::Initialize() {
+    HitchDetector::Scope hitch(HitchEvent::Transition, "TitleGameState::Initialize");
+    InitialiseTimeline();
     LoadResources();
     return true;
 }
 
+void TitleGameState::InitialiseTimeline() {
+    introTextTrack_ = timeline_.AddTrack("introTextOpacity", {
+        {INTRO_TEXT_START, 0.0f},
+        {INTRO_TEXT_FULL, 1.0f},
+        {INTRO_TEXT_HOLD, 1.0f},
+        {INTRO_TEXT_END, 0.0f}
+    });
+    fadeOutTrack_ = timeline_.AddTrack("fadeOutOpacity", {
+        {INTRO_TEXT_END, 1.0f},
+        {FADE_TO_BLACK_END, 0.0f},
+        {WHITE_FLASH_END, 0.0f}
+    });
+    timeline_.Load(TIMELINE_PATH);
+    timeline_.Evaluate(0);
+}
+
 void TitleGameState::LoadResources() {
-    auto resourcePaths = TitleResources::GetAllResourcePaths();
-    for (const auto& path : resourcePaths) {
-        if (!ResourceManager::GetInstance().LoadTexture(path)) {
-            std::cerr << "Failed to load resource: " << path << std::endl;
+    MemoryRegistry& memory = MemoryRegistry::GetInstance();
+    for (const AssetId& asset : TitleResources::GetTextures()) {
+        HitchDetector::Scope hitch(HitchEvent::Texture, asset.GetSonicOrcaPath());
+        SDL_Texture* texture = ResourceManager::GetInstance().LoadTexture(asset.GetSonicOrcaPath());
+        if (!texture) {
+            std::cerr << "Failed to load resource: " << asset.GetPath() << std::endl;
+        }
+        memory.TrackSharedTexture(texture, ResourceKind::Texture, MEMORY_OWNER, asset.GetSonicOrcaPath());
+    }
+
+    {
+        HitchDetector::Scope hitch(HitchEvent::Font, TitleResources::FONT.GetSonicOrcaPath());
+        font_ = std::make_unique<BitmapFont>();
+        if (!font_->Load("data/SONICORCA/FONTS/HUD.font", context_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
+            std::cerr << "Failed to load HUD font" << std::endl;
+        }
+
+        if (!font_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYSILVER.png", context_->GetRenderer())) {
+            std::cerr << "Failed to load HUD overlay" << std::endl;
         }
     }
+    memory.TrackTexture(font_->GetTexture(), ResourceKind::Font, MEMORY_OWNER, TitleResources::FONT.GetSonicOrcaPath());
+
+    AudioMixer& mixer = AudioMixer::GetInstance();
+    if (mixer.Initialize()) {
+        sparkleSound_ = mixer.LoadSound(TitleResources::SPARKLE_SOUND);
+        shootingStarSound_ = mixer.LoadSound(TitleResources::SHOOTING_STAR_SOUND);
+    }
 
-    font_ = std::make_unique<BitmapFont>();
-    if (!font_->Load("data/SONICORCA/FONTS/HUD.font", context_->GetRenderer(), "data/SONICORCA/FONTS/HUD")) {
-        std::cerr << "Failed to load HUD font" << std::endl;
+    animationGroup_ = std::make_unique<AnimationGroup>();
+    if (!animationGroup_->Load(TitleResources::ANIMATION_GROUP.GetSonicOrcaPath())) {
+        std::cerr << "Failed to load title animation group" << std::endl;
+    }
+    for (size_t i = 0; i < animationGroup_->GetTextureCount(); i++) {
+        memory.TrackSharedTexture(animationGroup_->GetTexture(i), ResourceKind::Texture, MEMORY_OWNER,
+                                  animationGroup_->GetTexturePath(i));
     }
 
-    if (!font_->LoadOverlay("data/SONICORCA/FONTS/HUD/OVERLAYSILVER.png", context_->GetRenderer())) {
-        std::cerr << "Failed to load HUD overlay" << std::endl;
+    // The emblem parts share one anchor; their frame origins lay out the logo.
+    animations_ = std::make_unique<AnimationPlayer>(animationGroup_.get());
+    for (int animation = TitleResources::HD_ANIMATION; animation <= TitleResources::TAILS_TAILS_ANIMATION; animation++) {
+        animations_->Add(animation, EMBLEM_X, EMBLEM_Y);
     }
+    spriteBatch_ = std::make_unique<SpriteBatch>(context_->GetRenderer());
 
     background_ = std::make_unique<Background>(context_);
     uilmao_ = std::make_unique<UserInterface>(context_, this);
@@ -40,6 +94,8 @@ void TitleGameState::LoadResources() {
 }
 
 void TitleGameState::Update() {
+    HitchDetector::GetInstance().MarkFrame();
+    IdlePacer::GetInstance().Tick(IsIdle());
     if (!loaded_) return;
 
     /*
@@ -50,30 +106,48 @@ void TitleGameState::Update() {
     }
     */
 
+    // The title keeps running while gameplay loads; the switch happens on the
+    // first frame the preloaded state is ready, and the gameplay state the
+    // engine builds next takes it over.
+    if (preloader_.IsLoading()) {
+        if (preloader_.Poll()) {
+            StatePreloader::Hand(preloader_.Take());
+            isFinished_ = true;
+        } else if (preloader_.HasFailed()) {
+            isFinished_ = true;
+        }
+    }
+
     switch (phase_) {
         case TitlePhase::IntroText:
-            ticks_++;
-            if (ticks_ == INTRO_TEXT_END) {
+            timeline_.Evaluate(++ticks_);
+            if (ticks_ >= INTRO_TEXT_END) {
                 phase_ = TitlePhase::FadeToBlack;
                 fadingOut_ = true;
             }
             break;
         case TitlePhase::FadeToBlack:
-            if (fadeOutOpacity_ > 0.0f) {
-                fadeOutOpacity_ -= 0.0166666675f;
-            } else {
+            timeline_.Evaluate(++ticks_);
+            fadeOutOpacity_ = timeline_.Get(fadeOutTrack_);
+            transition_.SetOverlay({0, 0, 0, 255}, 1.0f - fadeOutOpacity_);
+            if (fadeOutOpacity_ <= 0.0f) {
                 phase_ = TitlePhase::WhiteFlash;
-                whiteFlashTicks_ = 0;
+                transition_.SetOverlay({255, 255, 255, 255}, 1.0f);
+                AudioMixer::GetInstance().Play(sparkleSound_);
             }
             break;
         case TitlePhase::WhiteFlash:
-            whiteFlashTicks_++;
-            if (whiteFlashTicks_ > 15) {
+            timeline_.Evaluate(++ticks_);
+            if (ticks_ >= timeline_.GetDuration()) {
                 phase_ = TitlePhase::MainTitle;
+                transition_.Clear();
+                AudioMixer::GetInstance().Play(shootingStarSound_);
+                AudioMixer::GetInstance().GetMusic().Play(TitleResources::MUSIC.GetSonicOrcaPath());
             }
             break;
         case TitlePhase::MainTitle:
             background_->Update();
+            animations_->Update();
             if (uilmao_) uilmao_->Update();
             break;
     }
@@ -82,41 +156,42 @@ void TitleGameState::Update() {
 void TitleGameState::Render() {
     if (!loaded_) return;
 
-    switch (phase_) {
-        case TitlePhase::IntroText:
-            background_->Render();
-            DrawIntroText();
-            break;
-        case TitlePhase::FadeToBlack:
-            background_->Render();
-            DrawIntroText();
-            if (fadeOutOpacity_ < 1.0f) {
-                SDL_SetRenderDrawColor(context_->GetRenderer(), 0, 0, 0, static_cast<Uint8>((1.0f - fadeOutOpacity_) * 255));
-                SDL_RenderFillRect(context_->GetRenderer(), nullptr);
-            }
-            break;
-        case TitlePhase::WhiteFlash:
-            SDL_SetRenderDrawColor(context_->GetRenderer(), 255, 255, 255, 255);
-            SDL_RenderFillRect(context_->GetRenderer(), nullptr);
-            break;
-        case TitlePhase::MainTitle:
-            background_->Render();
-            if (uilmao_) uilmao_->Draw();
-            break;
+    OverdrawMap& overdraw = OverdrawMap::GetInstance();
+    overdraw.BeginFrame(context_->GetRenderer());
+
+    if (transition_.IsSceneVisible()) {
+        switch (phase_) {
+            case TitlePhase::IntroText:
+            case TitlePhase::FadeToBlack:
+                background_->Render();
+                DrawIntroText();
+                break;
+            case TitlePhase::WhiteFlash:
+                break;
+            case TitlePhase::MainTitle:
+                background_->Render();
+                spriteBatch_->Begin();
+                animations_->Draw(*spriteBatch_);
+                spriteBatch_->End();
+                if (uilmao_) uilmao_->Draw();
+                break;
+        }
     }
+    transition_.Render(context_->GetRenderer());
+    overdraw.EndFrame(context_->GetRenderer());
 }
 
-void TitleGameState::HandleEvent(const SDL_Event& event) {}
+void TitleGameState::HandleEvent(const SDL_Event& event) {
+    if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F9) {
+        MemoryRegistry::GetInstance().DumpJson(MemoryRegistry::DUMP_PATH);
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F7) {
+        OverdrawMap::GetInstance().Toggle();
+    }
+}
 
 void TitleGameState::DrawIntroText() {
-    float opacity = 0.0f;
-    if (ticks_ >= INTRO_TEXT_START && ticks_ < INTRO_TEXT_FULL) {
-        opacity = static_cast<float>(ticks_ - INTRO_TEXT_START) / (INTRO_TEXT_FULL - INTRO_TEXT_START);
-    } else if (ticks_ >= INTRO_TEXT_FULL && ticks_ < INTRO_TEXT_HOLD) {
-        opacity = 1.0f;
-    } else if (ticks_ >= INTRO_TEXT_HOLD && ticks_ < INTRO_TEXT_END) {
-        opacity = 1.0f - static_cast<float>(ticks_ - INTRO_TEXT_HOLD) / (INTRO_TEXT_END - INTRO_TEXT_HOLD);
-    }
+    float opacity = timeline_.Get(introTextTrack_);
 
     if (opacity <= 0.0f || !font_) return;
 
@@ -138,8 +213,10 @@ void TitleGameState::DrawIntroText() {
 
 void TitleGameState::RestartEvents() {
     ticks_ = 0;
+    timeline_.Evaluate(0);
     fadeOutOpacity_ = 1.0f;
     fadingOut_ = false;
+    transition_.Clear();
     if (background_) {
         background_->Reset();
     }
@@ -150,7 +227,12 @@ void TitleGameState::RestartEvents() {
 }
 
 void TitleGameState::TransitionToGameplay() {
+    if (preloader_.IsLoading() || isFinished_) return;
+
+    AudioMixer& mixer = AudioMixer::GetInstance();
+    mixer.GetMusic().FadeOut(mixer.GetFrequency() * MUSIC_FADE_MS / 1000);
+
     auto gameplayState = std::make_unique<GameplayState>(context_);
-    gameplayState->SetCharacterSelection(uilmao_->GetCharacterSelection());    
-    isFinished_ = true;
+    gameplayState->SetCharacterSelection(uilmao_->GetCharacterSelection());
+    preloader_.Start(std::move(gameplayState));
 } 
\ No newline at end of file
@@ -4,9 +4,15 @@
 #include <core/GameContext.hpp>
 #include <resources/ResourceManager.hpp>
 #include <graphics/BitmapFont.hpp>
+#include "graphics/AnimationGroup.hpp"
+#include "graphics/AnimationPlayer.hpp"
+#include "graphics/SpriteBatch.hpp"
+#include "graphics/Timeline.hpp"
+#include "graphics/TransitionLayer.hpp"
 #include "Title/Background.hpp"
 #include "Title/UserInterface.hpp"
 #include "GameplayState.hpp"
+#include "core/StatePreloader.hpp"
 #include <SDL2/SDL.h>
 #include <string>
 #include <memory>
@@ -23,8 +29,11 @@ public:
     void HandleEvent(const SDL_Event& event) override;
     void TransitionToGameplay();
 
+    static constexpr const char* MEMORY_OWNER = "Title";
+
 private:
     void LoadResources();
+    void InitialiseTimeline();
     void DrawIntroText();
     void RestartEvents();
 
@@ -32,16 +41,32 @@ private:
     std::unique_ptr<Background> background_;
     std::unique_ptr<UserInterface> uilmao_;
     std::unique_ptr<BitmapFont> font_;
+    std::unique_ptr<AnimationGroup> animationGroup_;
+    std::unique_ptr<AnimationPlayer> animations_;
+    std::unique_ptr<SpriteBatch> spriteBatch_;
+    Timeline timeline_;
+    StatePreloader preloader_;
+    int sparkleSound_ = -1;
+    int shootingStarSound_ = -1;
+    int introTextTrack_ = 0;
+    int fadeOutTrack_ = 0;
     
     int ticks_ = 0;
     bool loaded_ = false;
     float fadeOutOpacity_ = 1.0f;
+    TransitionLayer transition_;
     bool fadingOut_ = false;
     
     static constexpr int INTRO_TEXT_START = 60;
     static constexpr int INTRO_TEXT_FULL = 120;
     static constexpr int INTRO_TEXT_HOLD = 180;
     static constexpr int INTRO_TEXT_END = 240;
+    static constexpr int FADE_TO_BLACK_END = 300;
+    static constexpr int WHITE_FLASH_END = 316;
+    static constexpr int MUSIC_FADE_MS = 500;
+    static constexpr const char* TIMELINE_PATH = "data/S2HDPP/TIMELINES/TITLE.json";
+    static constexpr float EMBLEM_X = 960.0f;
+    static constexpr float EMBLEM_Y = 440.0f;
 
     enum class TitlePhase {
         IntroText,
@@ -50,6 +75,5 @@ private:
         MainTitle
     };
     TitlePhase phase_ = TitlePhase::IntroText;
-    int whiteFlashTicks_ = 0;
     bool isFinished_ = false;
 }; 
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "graphics/SpriteSheet.hpp"
+#include <SDL2/SDL_image.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Offline trimmer for fixed-cell sprite sheets. Writes the packed image and
+// its layout, which SpriteSheet picks up next to the image at load time.
+//
+//   s2hdpp-trim <input.png> <cellWidth> <cellHeight> <frames> <output.png> [columns]
+int main(int argc, char* args[]) {
+    if (argc < 6) {
+        std::fprintf(stderr, "Usage: %s <input.png> <cellWidth> <cellHeight> <frames> <output.png> [columns]\n", args[0]);
+        return 1;
+    }
+
+    int cellWidth = std::atoi(args[2]);
+    int cellHeight = std::atoi(args[3]);
+    int frameCount = std::atoi(args[4]);
+    int columns = argc > 6 ? std::atoi(args[6]) : 0;
+    if (cellWidth <= 0 || cellHeight <= 0 || frameCount <= 0) {
+        std::fprintf(stderr, "Cell size and frame count must be positive\n");
+        return 1;
+    }
+
+    SDL_Surface* input = IMG_Load(args[1]);
+    if (!input) {
+        std::fprintf(stderr, "Failed to load %s: %s\n", args[1], IMG_GetError());
+        return 1;
+    }
+
+    int sheetColumns = columns > 0 ? columns : frameCount;
+    int rows = (frameCount + sheetColumns - 1) / sheetColumns;
+    if (input->w < sheetColumns * cellWidth || input->h < rows * cellHeight) {
+        std::fprintf(stderr, "%s is smaller than %d frames of %dx%d\n", args[1], frameCount, cellWidth, cellHeight);
+        SDL_FreeSurface(input);
+        return 1;
+    }
+
+    SpriteSheet sheet;
+    sheet.SetGrid(cellWidth, cellHeight, frameCount, columns);
+    SDL_Surface* packed = sheet.Trim(input);
+    if (!packed) {
+        std::fprintf(stderr, "Failed to trim %s: %s\n", args[1], SDL_GetError());
+        SDL_FreeSurface(input);
+        return 1;
+    }
+
+    std::string output = args[5];
+    bool saved = IMG_SavePNG(packed, output.c_str()) == 0 && sheet.Save(SpriteSheet::GetLayoutPath(output));
+
+    long long before = static_cast<long long>(input->w) * input->h;
+    long long after = static_cast<long long>(packed->w) * packed->h;
+    long long drawnBefore = static_cast<long long>(cellWidth) * cellHeight * frameCount;
+    long long drawn = 0;
+    for (int i = 0; i < sheet.GetFrameCount(); i++) {
+        drawn += static_cast<long long>(sheet.GetFrame(i).source.w) * sheet.GetFrame(i).source.h;
+    }
+    std::printf("%s: %dx%d -> %dx%d, %.0f%% of the texels, %.0f%% of the pixels drawn per frame\n",
+                args[1], input->w, input->h, packed->w, packed->h,
+                100.0 * after / before, 100.0 * drawn / drawnBefore);
+
+    SDL_FreeSurface(packed);
+    SDL_FreeSurface(input);
+    if (!saved) {
+        std::fprintf(stderr, "Failed to write %s\n", output.c_str());
+        return 1;
+    }
+    return 0;
+}